@@ -14,8 +14,16 @@ namespace WebXR.InputSystem
 
     public bool updateHandsAllowed { get; set; } = true;
 
+    // Reads the joints from XRInputSubsystem's latched copy of the XR frame, see WebXRSettings.UseNativeHands.
+    public bool useNativeHands { get; set; } = false;
+
     private static Vector3 MIDDLE_METACARPAL_TO_PALM = new Vector3(0, 0.006376f, 0.013537f);
 
+    // XRHandData offsets in the native hand block
+    private const int NATIVE_HAND_ENABLED = 1;
+    private const int NATIVE_HAND_JOINTS = 12;
+    private const int NATIVE_JOINT_LENGTH = 8;
+
     [Preserve]
     private WebXRHandData leftHandData = new WebXRHandData();
     [Preserve]
@@ -74,6 +82,11 @@ namespace WebXR.InputSystem
         ref Pose leftHandRootPose, NativeArray<XRHandJoint> leftHandJoints,
         ref Pose rightHandRootPose, NativeArray<XRHandJoint> rightHandJoints)
     {
+      if (useNativeHands)
+      {
+        return TryUpdateNativeHands(ref leftHandRootPose, leftHandJoints, ref rightHandRootPose, rightHandJoints);
+      }
+
       if (!updateHandsAllowed)
         return XRHandSubsystem.UpdateSuccessFlags.None;
 
@@ -90,6 +103,55 @@ namespace WebXR.InputSystem
       return successFlags;
     }
 
+    private XRHandSubsystem.UpdateSuccessFlags TryUpdateNativeHands(
+        ref Pose leftHandRootPose, NativeArray<XRHandJoint> leftHandJoints,
+        ref Pose rightHandRootPose, NativeArray<XRHandJoint> rightHandJoints)
+    {
+      var successFlags = XRHandSubsystem.UpdateSuccessFlags.None;
+      if (UpdateNativeData(Handedness.Left, leftHandJoints, ref leftHandRootPose))
+        successFlags |= XRHandSubsystem.UpdateSuccessFlags.LeftHandRootPose | XRHandSubsystem.UpdateSuccessFlags.LeftHandJoints;
+
+      if (UpdateNativeData(Handedness.Right, rightHandJoints, ref rightHandRootPose))
+        successFlags |= XRHandSubsystem.UpdateSuccessFlags.RightHandRootPose | XRHandSubsystem.UpdateSuccessFlags.RightHandJoints;
+      return successFlags;
+    }
+
+    private unsafe bool UpdateNativeData(Handedness handedness, NativeArray<XRHandJoint> handJointArray, ref Pose rootPose)
+    {
+      if (WebXRManager.Instance == null)
+        return false;
+
+      float* handData = (float*)WebXRManager.Instance.GetNativeHandData((int)handedness);
+      if (handData == null || handData[NATIVE_HAND_ENABLED] == 0)
+        return false;
+
+      float* joints = handData + NATIVE_HAND_JOINTS;
+      rootPose = GetNativeJointPose(joints, 0);
+      for (int jointIndex = 0; jointIndex < handJointArray.Length; ++jointIndex)
+      {
+        // The palm is offset from the middle finger metacarpal, the other joints are in WebXR order after it.
+        int webxrJointIndex = jointIndex == 1 ? 10 : Mathf.Max(0, jointIndex - 1);
+        var pose = GetNativeJointPose(joints, webxrJointIndex);
+        if (jointIndex == 1)
+          pose.position += pose.rotation * MIDDLE_METACARPAL_TO_PALM;
+
+        handJointArray[jointIndex] = XRHandProviderUtility.CreateJoint(
+            handedness,
+            XRHandJointTrackingState.Pose | XRHandJointTrackingState.Radius,
+            XRHandJointIDUtility.FromIndex(jointIndex),
+            pose,
+            joints[webxrJointIndex * NATIVE_JOINT_LENGTH + 7]);
+      }
+      return true;
+    }
+
+    private static unsafe Pose GetNativeJointPose(float* joints, int webxrJointIndex)
+    {
+      float* joint = joints + webxrJointIndex * NATIVE_JOINT_LENGTH;
+      return new Pose(new Vector3(joint[0], joint[1], joint[2]),
+                      new Quaternion(joint[3], joint[4], joint[5], joint[6]));
+    }
+
     [Preserve]
     void UpdateData(Handedness handedness, WebXRHandData handData, NativeArray<XRHandJoint> handJointArray, ref Pose rootPose)
     {
@@ -19,6 +19,11 @@ namespace WebXR.InputSystem
       handsProvider.updateHandsAllowed = allowed;
     }
 
+    internal void SetUseNativeHands(bool useNativeHands)
+    {
+      handsProvider.useNativeHands = useNativeHands;
+    }
+
     internal void SetIsTracked(Handedness handedness, bool isTracked)
     {
       handsProvider.SetIsTracked(handedness, isTracked);
@@ -45,9 +45,21 @@ namespace WebXR.InputSystem
     private static WebXRController right = null;
     private static bool hasLeftProfiles = false;
     private static bool hasRightProfiles = false;
+    // XRInputSubsystem creates the controllers, only their profiles are needed here.
+    private static bool useNativeControllers = false;
 
 #if XR_HANDS_1_1_OR_NEWER
     private static WebXRHandsSubsystem webXRHandsSubsystem = null;
+    // The hands provider reads the joints natively and MetaAimHand reads the pointer from the native hand block,
+    // the managed hand updates are not decoded.
+    private static bool useNativeHands = false;
+    // XRHandData offsets in the native hand block
+    private const int NATIVE_HAND_FRAME = 0;
+    private const int NATIVE_HAND_ENABLED = 1;
+    private const int NATIVE_HAND_TRIGGER = 3;
+    private const int NATIVE_HAND_POINTER = 5;
+    private static int leftNativeHandFrame = -1;
+    private static int rightNativeHandFrame = -1;
     private static XRHandProviderUtility.SubsystemUpdater subsystemUpdater;
 #endif
 
@@ -84,6 +96,8 @@ namespace WebXR.InputSystem
         }
       }
       subsystemUpdater = new XRHandProviderUtility.SubsystemUpdater(webXRHandsSubsystem);
+      useNativeHands = WebXRSettings.GetSettings()?.UseNativeHands == true;
+      webXRHandsSubsystem?.SetUseNativeHands(useNativeHands);
 #endif
     }
 
@@ -99,9 +113,24 @@ namespace WebXR.InputSystem
         InputSystem.onDeviceCommand += HandleOnDeviceCommand;
       }
       WebXRManager.OnXRChange += OnXRChange;
-      WebXRManager.OnControllerUpdate += OnControllerUpdate;
+      useNativeControllers = WebXRSettings.GetSettings()?.UseNativeControllers == true;
+      if (useNativeControllers)
+      {
+        WebXRManager.OnInputProfilesUpdate += OnInputProfilesUpdate;
+      }
+      else
+      {
+        WebXRManager.OnControllerUpdate += OnControllerUpdate;
+      }
 #if XR_HANDS_1_1_OR_NEWER
-      WebXRManager.OnHandUpdate += OnHandUpdate;
+      if (useNativeHands)
+      {
+        InputSystem.onBeforeUpdate += OnBeforeInputUpdate;
+      }
+      else
+      {
+        WebXRManager.OnHandUpdate += OnHandUpdate;
+      }
       webXRHandsSubsystem?.Start();
       subsystemUpdater?.Start();
 #endif
@@ -120,8 +149,10 @@ namespace WebXR.InputSystem
       }
       RemoveAllDevices();
       WebXRManager.OnXRChange -= OnXRChange;
+      WebXRManager.OnInputProfilesUpdate -= OnInputProfilesUpdate;
       WebXRManager.OnControllerUpdate -= OnControllerUpdate;
 #if XR_HANDS_1_1_OR_NEWER
+      InputSystem.onBeforeUpdate -= OnBeforeInputUpdate;
       WebXRManager.OnHandUpdate -= OnHandUpdate;
       webXRHandsSubsystem?.Stop();
       subsystemUpdater?.Stop();
@@ -221,6 +252,22 @@ namespace WebXR.InputSystem
       }
     }
 
+    private static void OnInputProfilesUpdate(WebXRControllersProfiles controllersProfiles)
+    {
+      if (!hasLeftProfiles && controllersProfiles.controller2 != null && controllersProfiles.controller2.Length > 0)
+      {
+        leftProfiles = controllersProfiles.controller2;
+        hasLeftProfiles = true;
+        OnLeftControllerProfiles?.Invoke();
+      }
+      if (!hasRightProfiles && controllersProfiles.controller1 != null && controllersProfiles.controller1.Length > 0)
+      {
+        rightProfiles = controllersProfiles.controller1;
+        hasRightProfiles = true;
+        OnRightControllerProfiles?.Invoke();
+      }
+    }
+
     private static void UpdateController(WebXRControllerData controllerData, ref WebXRController hand)
     {
       if (controllerData.enabled)
@@ -254,48 +301,92 @@ namespace WebXR.InputSystem
       {
         webXRHandsSubsystem?.SetUpdateHandsAllowed(true);
         webXRHandsSubsystem?.UpdateHandJoints(handData);
-        MetaAimFlags aimFlags = MetaAimFlags.Computed | MetaAimFlags.Valid;
-        if (handData.trigger > MetaAimHand.pressThreshold)
-        {
-          aimFlags |= MetaAimFlags.IndexPinching;
-        }
-        switch (handData.hand)
-        {
-          case 1:
-            MetaAimHand.left ??= MetaAimHand.CreateHand(InputDeviceCharacteristics.Left);
-            MetaAimHand.left.UpdateHand(
-              true,
-              aimFlags,
-              new Pose(handData.pointerPosition, handData.pointerRotation),
-              handData.trigger,
-              0,
-              0,
-              0);
-            break;
-          case 2:
-            MetaAimHand.right ??= MetaAimHand.CreateHand(InputDeviceCharacteristics.Right);
-            MetaAimHand.right.UpdateHand(
-              true,
-              aimFlags,
-              new Pose(handData.pointerPosition, handData.pointerRotation),
-              handData.trigger,
-              0,
-              0,
-              0);
-            break;
-        }
+        UpdateAimHand(handData.hand, new Pose(handData.pointerPosition, handData.pointerRotation), handData.trigger);
       }
       else
       {
-        switch (handData.hand)
-        {
-          case 1:
-            DisableHandLeft();
-            break;
-          case 2:
-            DisableHandRight();
-            break;
-        }
+        DisableAimHand(handData.hand);
+      }
+    }
+
+    // Native hands, once per XR frame.
+    private static void OnBeforeInputUpdate()
+    {
+      if (WebXRManager.Instance == null)
+      {
+        return;
+      }
+      UpdateNativeAimHand(1, ref leftNativeHandFrame);
+      UpdateNativeAimHand(2, ref rightNativeHandFrame);
+    }
+
+    private static unsafe void UpdateNativeAimHand(int hand, ref int lastFrame)
+    {
+      float* handData = (float*)WebXRManager.Instance.GetNativeHandData(hand);
+      if (handData == null || handData[NATIVE_HAND_ENABLED] == 0)
+      {
+        lastFrame = -1;
+        DisableAimHand(hand);
+        return;
+      }
+      int frame = (int)handData[NATIVE_HAND_FRAME];
+      if (frame == lastFrame)
+      {
+        return;
+      }
+      lastFrame = frame;
+      float* pointer = handData + NATIVE_HAND_POINTER;
+      UpdateAimHand(
+        hand,
+        new Pose(new Vector3(pointer[0], pointer[1], pointer[2]),
+                 new Quaternion(pointer[3], pointer[4], pointer[5], pointer[6])),
+        handData[NATIVE_HAND_TRIGGER]);
+    }
+
+    private static void UpdateAimHand(int hand, Pose pointerPose, float trigger)
+    {
+      MetaAimFlags aimFlags = MetaAimFlags.Computed | MetaAimFlags.Valid;
+      if (trigger > MetaAimHand.pressThreshold)
+      {
+        aimFlags |= MetaAimFlags.IndexPinching;
+      }
+      switch (hand)
+      {
+        case 1:
+          MetaAimHand.left ??= MetaAimHand.CreateHand(InputDeviceCharacteristics.Left);
+          MetaAimHand.left.UpdateHand(
+            true,
+            aimFlags,
+            pointerPose,
+            trigger,
+            0,
+            0,
+            0);
+          break;
+        case 2:
+          MetaAimHand.right ??= MetaAimHand.CreateHand(InputDeviceCharacteristics.Right);
+          MetaAimHand.right.UpdateHand(
+            true,
+            aimFlags,
+            pointerPose,
+            trigger,
+            0,
+            0,
+            0);
+          break;
+      }
+    }
+
+    private static void DisableAimHand(int hand)
+    {
+      switch (hand)
+      {
+        case 1:
+          DisableHandLeft();
+          break;
+        case 2:
+          DisableHandRight();
+          break;
       }
     }
 
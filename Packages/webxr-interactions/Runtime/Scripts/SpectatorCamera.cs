@@ -6,6 +6,8 @@ namespace WebXR.Interactions
   /// <summary>
   /// Controls the Spectator Camera, enable render it when in XR mode.
   /// Notice that the Depth of the attached Camera should be higher than the other cameras on the scene.
+  /// With renderInXRFrame, the XR camera renders the spectator view as an extra pass of the XR frame instead,
+  /// at a reduced resolution, and the attached Camera only provides the pose and field of view.
   /// </summary>
   [RequireComponent(typeof(Camera))]
   public class SpectatorCamera : MonoBehaviour
@@ -13,7 +15,15 @@ namespace WebXR.Interactions
     private Camera _camera;
     [SerializeField]
     private bool enableInXR = false;
+    [SerializeField]
+    private bool renderInXRFrame = false;
+    [SerializeField]
+    [Range(0.25f, 1f)]
+    private float xrFrameResolutionScale = 0.5f;
+    [SerializeField]
+    private Camera xrCamera;
     private WebXRState currentXRState = WebXRState.NORMAL;
+    private bool isXRFrameViewEnabled = false;
 
     private void Awake()
     {
@@ -32,6 +42,37 @@ namespace WebXR.Interactions
     {
       WebXRManager.OnXRChange -= HandleOnXRChange;
       RenderPipelineManager.beginCameraRendering -= OnBeginCameraRendering;
+      DisableXRFrameView();
+    }
+
+    private void LateUpdate()
+    {
+      if (!renderInXRFrame || !enableInXR || currentXRState == WebXRState.NORMAL)
+      {
+        DisableXRFrameView();
+        return;
+      }
+      var headCamera = xrCamera != null ? xrCamera : Camera.main;
+      if (headCamera == null)
+      {
+        DisableXRFrameView();
+        return;
+      }
+      // The XR frame poses are relative to the XR camera.
+      var head = headCamera.transform;
+      var pose = new Pose(head.InverseTransformPoint(transform.position),
+                          Quaternion.Inverse(head.rotation) * transform.rotation);
+      WebXRManager.Instance.SetSpectatorView(true, pose, _camera.fieldOfView, _camera.aspect, xrFrameResolutionScale);
+      isXRFrameViewEnabled = true;
+    }
+
+    private void DisableXRFrameView()
+    {
+      if (isXRFrameViewEnabled)
+      {
+        WebXRManager.Instance.SetSpectatorView(false, Pose.identity, 0, 0, 0);
+        isXRFrameViewEnabled = false;
+      }
     }
 
     void OnBeginCameraRendering(ScriptableRenderContext context, Camera camera)
@@ -55,7 +96,7 @@ namespace WebXR.Interactions
 
     private void TryUpdateCameraState()
     {
-      bool newState = enableInXR && currentXRState != WebXRState.NORMAL;
+      bool newState = enableInXR && !renderInXRFrame && currentXRState != WebXRState.NORMAL;
       if (_camera.enabled != newState)
       {
         _camera.enabled = newState;
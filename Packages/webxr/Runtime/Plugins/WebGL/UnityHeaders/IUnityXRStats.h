@@ -0,0 +1,61 @@
+// Unity Native Plugin API copyright © 2019 Unity Technologies ApS
+//
+// Licensed under the Unity Companion License for Unity - dependent projects--see [Unity Companion License](http://www.unity3d.com/legal/licenses/Unity_Companion_License).
+//
+// Unless expressly provided otherwise, the Software under this license is made available strictly on an “AS IS” BASIS WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED.Please review the license for details on these and other terms and conditions.
+
+#pragma once
+#if !UNITY
+#include "UnitySubsystemTypes.h"
+#else
+#include "Modules/Subsystems/ProviderInterface/UnitySubsystemTypes.h"
+#endif
+
+/// @file IUnityXRStats.h
+/// @brief XR interface for reporting provider stats to the XRStats C# API
+/// @see UnityXRDisplayStats.h
+
+/// Options for a stat definition
+typedef enum UnityXRStatOptions
+{
+    /// No options, the stat keeps its value until it is set again
+    kUnityXRStatOptionNone = 0,
+    /// The stat is reset to 0 on every update
+    kUnityXRStatOptionClearOnUpdate = 1 << 0,
+    /// All options
+    kUnityXRStatOptionAll = (1 << 1) - 1
+} UnityXRStatOptions;
+
+/// Handle of a registered stat
+typedef void* UnityXRStatId;
+
+/// @brief XR interface for registering and updating stats.
+UNITY_DECLARE_INTERFACE(IUnityXRStats)
+{
+    /// Register a subsystem as a source of stats. Call this before registering any stat definitions for the subsystem.
+    ///
+    /// @param[in] handle Handle obtained from UnityLifecycleProvider callbacks.
+    /// @return kUnitySubsystemErrorCodeSuccess Successfully registered
+    /// @return kUnitySubsystemErrorCodeFailure The subsystem was already registered
+    UnitySubsystemErrorCode(UNITY_INTERFACE_API * RegisterStatSource)(UnitySubsystemHandle handle);
+
+    /// Register a stat of a subsystem. The tag is the name the stat is queried with from C#.
+    ///
+    /// @param[in] handle Handle obtained from UnityLifecycleProvider callbacks.
+    /// @param[in] tag Name of the stat, see UnityXRDisplayStats.h for the common display stats.
+    /// @param[in] flags Combination of UnityXRStatOptions.
+    /// @param[out] statId Handle of the stat, used to set its value.
+    /// @return kUnitySubsystemErrorCodeSuccess Successfully registered
+    /// @return kUnitySubsystemErrorCodeInvalidArguments tag or statId is null, or the subsystem isn't a registered stat source
+    UnitySubsystemErrorCode(UNITY_INTERFACE_API * RegisterStatDefinition)(UnitySubsystemHandle handle, const char* tag, unsigned int flags, UnityXRStatId* statId);
+
+    /// Set the value of a stat for the current frame.
+    ///
+    /// @param[in] statId Handle obtained from RegisterStatDefinition.
+    /// @param[in] value New value of the stat.
+    /// @return kUnitySubsystemErrorCodeSuccess Successfully set
+    /// @return kUnitySubsystemErrorCodeInvalidArguments statId is not a registered stat
+    UnitySubsystemErrorCode(UNITY_INTERFACE_API * SetStatFloat)(UnityXRStatId statId, float value);
+};
+
+UNITY_REGISTER_INTERFACE_GUID(0x4D0F3BE2E7A64E3BULL, 0x9C4B6F2A5D1E8C07ULL, IUnityXRStats)
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "UnityHeaders/UnityXRTypes.h"
+
+// Modes of the eye views copy to the page canvas, set from WebXRSubsystem.SetCanvasMirrorMode.
+enum WebXRCanvasMirrorMode
+{
+    kWebXRCanvasMirrorNone = 0,
+    kWebXRCanvasMirrorLeftEye = 1,
+    kWebXRCanvasMirrorBothEyes = 2,
+    // Left eye, cropped to the canvas aspect instead of stretched.
+    kWebXRCanvasMirrorCropped = 3
+};
+
+struct WebXRCanvasMirrorBlit
+{
+    // Eye view copied, its slice when the source is a texture array.
+    int view;
+    // Normalized to the source texture.
+    UnityXRRectf srcRect;
+    // Normalized to the canvas.
+    UnityXRRectf destRect;
+};
+
+// Blits from the already rendered eye textures to the page canvas, so the page shows the headset view
+// without rendering the scene again. Has no Unity runtime dependencies so the rects can be checked on the host.
+struct WebXRCanvasMirror
+{
+    static const int kMaxBlits = 2;
+
+    // eyeRects are the eye viewports in the source texture, normalized. textureAspect is the source texture
+    // width over height in pixels, canvasAspect the displayed canvas width over height. Returns the blits count.
+    static int GetBlits(int mode, const UnityXRRectf* eyeRects, int eyesCount, float textureAspect, float canvasAspect, WebXRCanvasMirrorBlit* blits)
+    {
+        const UnityXRRectf fullRect = {0.0f, 0.0f, 1.0f, 1.0f};
+        if (eyesCount < 1)
+        {
+            return 0;
+        }
+        switch (mode)
+        {
+        case kWebXRCanvasMirrorLeftEye:
+            blits[0].view = 0;
+            blits[0].srcRect = eyeRects[0];
+            blits[0].destRect = fullRect;
+            return 1;
+        case kWebXRCanvasMirrorBothEyes:
+            for (int eye = 0; eye < eyesCount && eye < kMaxBlits; ++eye)
+            {
+                blits[eye].view = eye;
+                blits[eye].srcRect = eyeRects[eye];
+                blits[eye].destRect = fullRect;
+                if (eyesCount > 1)
+                {
+                    blits[eye].destRect.x = eye * 0.5f;
+                    blits[eye].destRect.width = 0.5f;
+                }
+            }
+            return eyesCount < kMaxBlits ? eyesCount : kMaxBlits;
+        case kWebXRCanvasMirrorCropped:
+            blits[0].view = 0;
+            blits[0].srcRect = GetCroppedRect(eyeRects[0], textureAspect, canvasAspect);
+            blits[0].destRect = fullRect;
+            return 1;
+        default:
+            return 0;
+        }
+    }
+
+    // Center of the rect with the canvas aspect.
+    static UnityXRRectf GetCroppedRect(const UnityXRRectf& rect, float textureAspect, float canvasAspect)
+    {
+        if (textureAspect <= 0.0f || canvasAspect <= 0.0f || rect.height <= 0.0f)
+        {
+            return rect;
+        }
+        UnityXRRectf cropped = rect;
+        float rectAspect = rect.width * textureAspect / rect.height;
+        if (rectAspect > canvasAspect)
+        {
+            cropped.width = rect.width * canvasAspect / rectAspect;
+            cropped.x = rect.x + 0.5f * (rect.width - cropped.width);
+        }
+        else
+        {
+            cropped.height = rect.height * rectAspect / canvasAspect;
+            cropped.y = rect.y + 0.5f * (rect.height - cropped.height);
+        }
+        return cropped;
+    }
+};
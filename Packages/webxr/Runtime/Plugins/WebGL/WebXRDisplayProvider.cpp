@@ -1,14 +1,88 @@
 #include "UnityHeaders/IUnityXRDisplay.h"
 #include "UnityHeaders/IUnityXRTrace.h"
 
+#include "WebXRCanvasMirror.h"
+#include "WebXRFoveation.h"
+#include "WebXRGpuTimerGL.h"
+#include "WebXRMirrorBlit.h"
+#include "WebXROcclusionMesh.h"
+#include "WebXRPerformancePolicy.h"
 #include "WebXRProviderContext.h"
+#include "WebXRResolutionGovernor.h"
+#include "WebXRSinglePass.h"
+#include "WebXRSpectatorView.h"
+#include "WebXRStatsReporter.h"
+#include "WebXRTexturePool.h"
+#include "WebXRViewLayout.h"
+#include <chrono>
 #include <cmath>
+#include <cstring>
+#include <stdint.h>
 #include <vector>
 
-#define SIDE_BY_SIDE 1
+extern "C"
+{
+  // webxr.jslib, applied to the current XR session.
+  extern int WebXRQuerySupportedFrameRates(float* frameRates, int maxCount);
+  extern float WebXRQueryFixedFoveation();
+  extern void WebXRApplyFixedFoveation(float level);
+  extern void WebXRApplyTargetFrameRate(float frameRate);
+  // Source rect in pixels, of the srcLayer slice for texture arrays (-1 otherwise), destination rect normalized to the canvas.
+  extern void WebXRBlitTextureToCanvas(uint32_t textureName, int srcLayer, int srcX, int srcY, int srcWidth, int srcHeight,
+      float destX, float destY, float destWidth, float destHeight);
+  extern float WebXRGetCanvasAspect();
+  // Copies the dirty composition layers textures, only valid inside the XR frame.
+  extern void WebXRUpdateCompositionLayers();
+}
+
 #define NUM_RENDER_PASSES 2
 static float s_PoseXPositionPerPass[] = {-1.0f, 1.0f};
 
+// webxr.jspre shares the texture of the WebXR projection layer when WebXRSettings.RenderToProjectionLayer is on.
+// The layer texture holds both views side by side, single-pass frames render there side by side too.
+static bool IsRenderingToLayerTexture(const float* viewsDataArray)
+{
+    return *(viewsDataArray + 58) > 0;
+}
+
+// Set from WebXRSettings by the loader, before the display subsystem starts.
+// Single-pass frames render into a 2 slices texture array instead of a side by side texture,
+// the layout single-pass instanced shaders expect. Not used when rendering to the layer texture.
+static bool s_SinglePassTextureArrayEnabled = false;
+
+// Set from WebXRSettings by the loader, before the display subsystem starts.
+// Foveated rendering splits each eye into a reduced resolution outer pass and a full resolution
+// inner pass, composited by the mirror view blit. Used only in multi-pass.
+static bool s_FoveatedRenderingEnabled = false;
+static float s_FoveatedInnerSize = 0.5f;
+static float s_FoveatedOuterScale = 0.5f;
+
+// Set from WebXRSettings by the loader, and at runtime from WebXRSubsystem.
+static bool s_AutomaticPerformanceEnabled = false;
+// Set at runtime from WebXRSubsystem, -1 and 0 until then. Kept for the sessions to come:
+// the supported frame rates and the layer are known only once a session runs.
+static float s_FixedFoveation = -1.0f;
+static float s_TargetFrameRate = 0.0f;
+
+// Set at runtime from WebXRSubsystem, see WebXRCanvasMirrorMode.
+static int s_CanvasMirrorMode = kWebXRCanvasMirrorNone;
+
+// Parts of the cached frame descriptor that must be rebuilt on the next frame.
+enum FrameDescDirtyFlags
+{
+    kFrameDescDirtyProjections = 1 << 0,
+    kFrameDescDirtyEyePoses = 1 << 1,
+    kFrameDescDirtyLayout = 1 << 2,
+    kFrameDescDirtyAll = kFrameDescDirtyProjections | kFrameDescDirtyEyePoses | kFrameDescDirtyLayout
+};
+
+// Smaller eye distance changes are tracking noise, not an IPD change.
+#define EYE_DISTANCE_EPSILON 0.0001f
+
+// Set from WebXRSettings by the loader, before the display subsystem starts.
+static bool s_DynamicResolutionEnabled = false;
+static float s_DynamicResolutionMinScale = 0.5f;
+
 // BEGIN WORKAROUND: skip first frame since we get invalid data.  Fix coming to trunk.
 static bool s_SkipFrame = true;
 #define WORKAROUND_SKIP_FIRST_FRAME()           \
@@ -37,22 +111,93 @@ public:
     UnitySubsystemErrorCode GfxThread_PopulateNextFrameDesc(const UnityXRFrameSetupHints& frameHints, UnityXRNextFrameDesc& nextFrame);
 
     UnitySubsystemErrorCode GfxThread_Stop();
-    UnitySubsystemErrorCode GfxThread_FinalBlitToGameViewBackBuffer(const UnityXRMirrorViewBlitInfo* mirrorBlitInfo, WebXRProviderContext& ctx);
 
     UnitySubsystemErrorCode UpdateDisplayState(UnityXRDisplayState* state);
 
     void Stop() override;
     void Shutdown() override;
 
+    void GetTexturePoolStats(uint32_t* hits, uint32_t* misses);
+    void GetDisplayStats(int* droppedFrameCount, int* framePresentCount, float* refreshRate, float* motionToPhoton, float* gpuFrameTime);
+    void GfxThread_BeginGpuTimerPass();
+    void SetAutomaticPerformance(bool enabled);
+    void SetFixedFoveation(float level);
+    float GetFixedFoveation();
+    void SetTargetFrameRate(float frameRate);
+    float GetTargetFrameRate();
+    int GetSupportedFrameRates(float* frameRates, int maxCount);
+    void SetSpectatorView(bool enabled, const UnityXRPose& pose, float fieldOfView, float aspect, float resolutionScale);
+    UnitySubsystemErrorCode QueryMirrorViewBlitDesc(const UnityXRMirrorViewBlitInfo& mirrorBlitInfo, UnityXRMirrorViewBlitDesc& blitDescriptor);
+
 private:
-    void CreateTextures(int numTextures, int textureArrayLength, float requestedTextureScale);
-    void DestroyTextures();
+    void CreateTextures(WebXRTextureLayout textureLayout, float requestedTextureScale);
+    void CreateFoveatedTextures(float requestedTextureScale);
+    UnityXRRenderTextureId AcquireTexture(int width, int height, int textureArrayLength);
+    bool UpdateTextureFormats(const UnityXRFrameSetupHints& frameHints);
+    void ReleaseTextures();
+    UnityXRRenderTextureId GetLayerTexture();
+    void AppendSpectatorPass(UnityXRNextFrameDesc& nextFrame);
+    void GfxThread_BlitToCanvas();
+    bool GetNativeTexture(UnityXRRenderTextureId textureId, uint32_t* textureName, int* width, int* height);
+    void UpdateFrameTiming();
+    void UpdateDirtyFlags(const UnityXRFrameSetupHints& frameHints, bool singlePassRendering, bool reallocateTextures);
+    void UpdateEyePoses(const float* viewsData);
+    void UpdateProjections(const float* viewsData);
+    UnityXRRenderTextureId GetPassTexture(int pass, UnityXRRenderTextureId layerTexture);
+    void PatchCachedFrameDesc(UnityXRRenderTextureId layerTexture, UnityXRNextFrameDesc& nextFrame);
 
     UnityXRPose GetPose(int pass);
     UnityXRProjection GetProjection(int pass);
+    UnityXRRectf GetViewportRect(int pass, const UnityXRFrameSetupHints& frameHints);
+    UnityXRRectf GetRenderViewport(const UnityXRFrameSetupHints& frameHints);
+    void GetCombinedCullingPass(UnityXRNextFrameDesc::UnityXRCullingPass& cullingPass);
+    UnityXROcclusionMeshId GetOcclusionMesh(int pass, const UnityXRProjection& projection);
+    void DestroyOcclusionMeshes();
 
 private:
     std::vector<UnityXRRenderTextureId> m_UnityTextures;
+    WebXRTexturePool m_TexturePool;
+    uint32_t m_LayerTextureName = 0;
+    UnityXRRenderTextureId m_LayerTextureId = 0;
+    WebXRSpectatorView m_SpectatorView;
+    UnityXRRenderTextureId m_SpectatorTextureId = 0;
+    int m_SpectatorTextureWidth = 0;
+    int m_SpectatorTextureHeight = 0;
+    bool m_SpectatorRendered = false;
+    UnityXROcclusionMeshId m_OcclusionMeshIds[NUM_RENDER_PASSES] = {};
+    UnityXRMatrix4x4 m_OcclusionMeshProjections[NUM_RENDER_PASSES];
+    WebXROcclusionMesh m_OcclusionMesh;
+    WebXRViewLayout m_ViewLayout;
+    WebXRResolutionGovernor m_ResolutionGovernor;
+    WebXRPerformancePolicy m_PerformancePolicy;
+    bool m_PerformanceChanged = false;
+    float m_AppliedFoveationLevel = 0.0f;
+    float m_AppliedTargetFrameRate = 0.0f;
+    WebXRStatsReporter m_StatsReporter;
+    WebXRGpuTimerBackendGL m_GpuTimerBackend;
+    WebXRGpuTimer m_GpuTimer;
+    static_assert(WebXRGpuTimer::kMaxPasses <= kWebXRStatsGPUTimePassCount, "Every measured pass has a stat");
+    // Pass events received since the frame setup, the next one starts that render pass.
+    int m_GpuTimerPassEvents = 0;
+    std::chrono::steady_clock::time_point m_FrameStartTime;
+    std::chrono::steady_clock::time_point m_FrameSubmitTime;
+    bool m_HasFrameTiming = false;
+    float m_TextureScale = 1.0f;
+    UnityXRRenderTextureFormat m_ColorFormat = kUnityXRRenderTextureFormatRGBA32;
+    UnityXRDepthTextureFormat m_DepthFormat = kUnityXRDepthTextureFormat24bitOrGreater;
+    uint32_t m_TextureFlags = 0;
+    // Last populated frame descriptor, reused as long as nothing in m_FrameDescDirtyFlags is set.
+    UnityXRNextFrameDesc m_CachedFrameDesc = {};
+    uint32_t m_FrameDescDirtyFlags = kFrameDescDirtyAll;
+    float m_CachedProjectionsData[NUM_RENDER_PASSES * 16] = {};
+    float m_EyeHalfDistance = -1.0f;
+    UnityXRProjection m_Projections[NUM_RENDER_PASSES];
+    UnityXRRectf m_InnerRects[NUM_RENDER_PASSES];
+    UnityXRProjection m_InnerProjections[NUM_RENDER_PASSES];
+    bool m_FoveatedFrame = false;
+    WebXRTextureLayout m_TextureLayout = kWebXRTextureLayoutSideBySide;
+    bool m_CachedSinglePassRendering = false;
+    float m_CachedViewportScale = 1.0f;
     float *m_ViewsDataArray;
     float viewWidth;
     float viewHeight;
@@ -60,10 +205,14 @@ private:
     float frameBufferHeight;
     bool hasMultipleViews = true;
     bool transparentBackground = false;
+    bool renderToLayerTexture = false;
+    bool foveatedRendering = false;
 };
 
 UnitySubsystemErrorCode WebXRDisplayProvider::Initialize()
 {
+    m_TexturePool.Initialize(m_Ctx.display, m_Handle);
+    m_StatsReporter.Register(m_Ctx.stats, m_Handle);
     return kUnitySubsystemErrorCodeSuccess;
 }
 
@@ -75,34 +224,58 @@ UnitySubsystemErrorCode WebXRDisplayProvider::Start()
     frameBufferWidth = *(m_ViewsDataArray + 56);
     frameBufferHeight = *(m_ViewsDataArray + 57);
     hasMultipleViews = *(m_ViewsDataArray + 54) > 1;
-    if (hasMultipleViews)
+    m_ViewLayout.Update(m_ViewsDataArray + 46, hasMultipleViews ? 2 : 1, frameBufferWidth, frameBufferHeight);
+    // Eye poses and projections are read again from the first frame snapshot.
+    m_EyeHalfDistance = -1.0f;
+    m_FrameDescDirtyFlags = kFrameDescDirtyAll;
+    transparentBackground = *(m_ViewsDataArray + 55) > 0;
+    renderToLayerTexture = IsRenderingToLayerTexture(m_ViewsDataArray);
+    // Nothing composites the passes when rendering into the layer texture.
+    foveatedRendering = s_FoveatedRenderingEnabled && !renderToLayerTexture;
+    // The compositor samples the whole layer texture, a smaller viewport can't be used there.
+    m_ResolutionGovernor.Configure(s_DynamicResolutionEnabled && !renderToLayerTexture, s_DynamicResolutionMinScale, 1.0f);
+    m_HasFrameTiming = false;
+    m_StatsReporter.Reset();
+
+    // Compositor foveation and frame rate are left to the browser until the app or the policy changes them.
+    // The display starts on the first frame of the session, its supported frame rates and layer are known by then.
+    float frameRates[WebXRPerformancePolicy::kMaxFrameRates];
+    int frameRatesCount = WebXRQuerySupportedFrameRates(frameRates, WebXRPerformancePolicy::kMaxFrameRates);
+    m_AppliedFoveationLevel = WebXRQueryFixedFoveation();
+    m_AppliedTargetFrameRate = 0.0f;
+    m_PerformancePolicy.Configure(s_AutomaticPerformanceEnabled, frameRates, frameRatesCount, m_AppliedFoveationLevel);
+    m_PerformanceChanged = false;
+    // Requests of the app from before the session.
+    if (s_FixedFoveation >= 0.0f)
     {
-      float viewsHalfDistance = 0.5f * sqrt(
-        pow((*(m_ViewsDataArray + 40) - *(m_ViewsDataArray + 43)), 2)
-        + pow((*(m_ViewsDataArray + 41) - *(m_ViewsDataArray + 44)), 2)
-        + pow((*(m_ViewsDataArray + 42) - *(m_ViewsDataArray + 45)), 2));
-      s_PoseXPositionPerPass[0] = -viewsHalfDistance;
-      s_PoseXPositionPerPass[1] = viewsHalfDistance;
+        SetFixedFoveation(s_FixedFoveation);
     }
-    else
+    if (s_TargetFrameRate > 0.0f)
     {
-      s_PoseXPositionPerPass[0] = 0;
-      s_PoseXPositionPerPass[1] = 0;
+        SetTargetFrameRate(s_TargetFrameRate);
     }
-    transparentBackground = *(m_ViewsDataArray + 55) > 0;
     return kUnitySubsystemErrorCodeSuccess;
 }
 
 UnitySubsystemErrorCode WebXRDisplayProvider::GfxThread_Start(UnityXRRenderingCapabilities& renderingCaps)
 {
-    renderingCaps.noSinglePassRenderingSupport = true;
+    // Single-pass is opt-in from the app side (WebXRSettings.UseSinglePassRendering),
+    // the frame hints tell us which mode to set up on each frame.
+    renderingCaps.noSinglePassRenderingSupport = false;
     renderingCaps.invalidateRenderStateAfterEachCallback = false;
-    renderingCaps.skipPresentToMainScreen = false;
+    // When rendering directly into the layer texture there's nothing left to present.
+    renderingCaps.skipPresentToMainScreen = IsRenderingToLayerTexture(WebXRGetViewsDataArray());
+    m_GpuTimer.Initialize(&m_GpuTimerBackend);
     return kUnitySubsystemErrorCodeSuccess;
 }
 
 UnitySubsystemErrorCode WebXRDisplayProvider::GfxThread_SubmitCurrentFrame()
 {
+    m_FrameSubmitTime = std::chrono::steady_clock::now();
+    m_GpuTimer.EndFrame();
+    m_StatsReporter.Publish();
+    GfxThread_BlitToCanvas();
+    WebXRUpdateCompositionLayers();
     return kUnitySubsystemErrorCodeSuccess;
 }
 
@@ -112,19 +285,50 @@ UnitySubsystemErrorCode WebXRDisplayProvider::GfxThread_PopulateNextFrameDesc(co
 
     // BlockUntilUnityShouldStartSubmittingRenderingCommands();
 
-    bool reallocateTextures = (m_UnityTextures.size() == 0);
+    // Single-pass needs two views, mono sessions (AR on phones) always use multi-pass.
+    bool singlePassRendering = frameHints.appSetup.singlePassRendering && hasMultipleViews;
+    // Foveation adds passes per eye, so it's used only with multi-pass.
+    bool foveated = foveatedRendering && !singlePassRendering;
+    WebXRTextureLayout textureLayout = renderToLayerTexture ? kWebXRTextureLayoutFramebuffer
+        : (singlePassRendering && s_SinglePassTextureArrayEnabled ? kWebXRTextureLayoutTextureArray : kWebXRTextureLayoutSideBySide);
+
+    UpdateFrameTiming();
+
+    // GPU times arrive a few frames late, they're kept as soon as they're read back.
+    if (m_GpuTimer.Poll())
+    {
+        m_StatsReporter.AddGpuFrame(m_GpuTimer.GetFrameTime(), m_GpuTimer.GetPassTimes(), m_GpuTimer.GetPassesCount());
+    }
+
+    // Poses and projections of this frame come from the snapshot, shared with the input subsystem.
+    m_Ctx.frameSnapshot.Latch(m_ViewsDataArray);
+
+    const float* viewsData = m_Ctx.frameSnapshot.viewsData;
+    m_StatsReporter.AddFrame(m_Ctx.frameSnapshot.frameNumber, *(viewsData + 60), *(viewsData + 61), *(viewsData + 62));
+
+    // Textures are allocated at the app requested scale (XRSettings.eyeTextureResolutionScale).
+    // Dynamic resolution only shrinks the viewports inside them, see GetViewportRect.
+    float textureScale = frameHints.appSetup.textureResolutionScale;
+
+    bool reallocateTextures = (m_UnityTextures.size() == 0) || textureScale != m_TextureScale || textureLayout != m_TextureLayout;
+    m_TextureLayout = textureLayout;
     if ((kUnityXRFrameSetupHintsChangedSinglePassRendering & frameHints.changedFlags) != 0)
     {
         reallocateTextures = true;
     }
     if ((kUnityXRFrameSetupHintsChangedRenderViewport & frameHints.changedFlags) != 0)
     {
-        // Change sampling UVs for compositor, pass through new viewport on `nextFrame`
+        // New viewport is passed through on `nextFrame` by GetViewportRect, no reallocation needed.
     }
     if ((kUnityXRFrameSetupHintsChangedTextureResolutionScale & frameHints.changedFlags) != 0)
     {
         reallocateTextures = true;
     }
+    if (UpdateTextureFormats(frameHints))
+    {
+        // There's no changed flag for the sRGB and 16 bit color hints, they're compared to the last ones.
+        reallocateTextures = true;
+    }
     if ((kUnityXRFrameSetuphintsChangedContentProtectionState & frameHints.changedFlags) != 0)
     {
         // App wants different content protection mode.
@@ -138,22 +342,85 @@ UnitySubsystemErrorCode WebXRDisplayProvider::GfxThread_PopulateNextFrameDesc(co
         // App changed focus plane, configure compositor if possible.
     }
 
-    if (reallocateTextures)
+    m_TexturePool.NextFrame();
+
+    UnityXRRenderTextureId layerTexture = 0;
+    if (renderToLayerTexture)
     {
-        DestroyTextures();
+        // The layer texture can change every frame, nothing else to allocate.
+        reallocateTextures = false;
+        layerTexture = GetLayerTexture();
+        if (layerTexture == 0)
+        {
+            nextFrame.renderPassesCount = 0;
+            return kUnitySubsystemErrorCodeSuccess;
+        }
+    }
 
-#if SIDE_BY_SIDE
-        int numTextures = 1;
-        int textureArrayLength = 0;
-#else
-        int numTextures = frameHints.appSetup.singlePassRendering ? NUM_RENDER_PASSES - 1 : NUM_RENDER_PASSES;
-        int textureArrayLength = frameHints.appSetup.singlePassRendering ? 2 : 0;
-#endif
-        CreateTextures(numTextures, textureArrayLength, frameHints.appSetup.textureResolutionScale);
+    if (reallocateTextures && foveated)
+    {
+        ReleaseTextures();
+        CreateFoveatedTextures(textureScale);
+    }
+    else if (reallocateTextures)
+    {
+        // Released textures stay in the pool, switching back to a recent size reuses them.
+        ReleaseTextures();
+        CreateTextures(textureLayout, textureScale);
+    }
+
+    // Everything Unity renders until SubmitCurrentFrame is timed, as pass 0 until
+    // the pass event of the next render pass, see OnGpuTimerPassEvent.
+    m_GpuTimer.BeginFrame();
+    m_GpuTimerPassEvents = 0;
+
+    UpdateDirtyFlags(frameHints, singlePassRendering, reallocateTextures);
+    m_FoveatedFrame = foveated;
+    if (m_FrameDescDirtyFlags == 0)
+    {
+        // Same layout, eye poses and projections as the last frame, only the textures can differ.
+        PatchCachedFrameDesc(layerTexture, nextFrame);
+        AppendSpectatorPass(nextFrame);
+        return kUnitySubsystemErrorCodeSuccess;
     }
 
     // Frame hints tells us if we should setup our renderpasses with a single pass
-    if (!frameHints.appSetup.singlePassRendering)
+    if (foveated)
+    {
+        // Outer passes of all eyes first, then the inner passes, both into side by side textures.
+        int eyesCount = hasMultipleViews ? 2 : 1;
+        nextFrame.renderPassesCount = eyesCount * 2;
+
+        for (int pass = 0; pass < nextFrame.renderPassesCount; ++pass)
+        {
+            int eye = pass % eyesCount;
+            bool innerPass = pass >= eyesCount;
+            auto& renderPass = nextFrame.renderPasses[pass];
+            renderPass.textureId = GetPassTexture(pass, layerTexture);
+            renderPass.renderParamsCount = 1;
+            renderPass.cullingPassIndex = 0;
+
+            auto& renderParams = renderPass.renderParams[0];
+            renderParams.deviceAnchorToEyePose = GetPose(eye);
+            renderParams.projection = innerPass ? m_InnerProjections[eye] : GetProjection(eye);
+            // The inner view is all inside the lens visible area.
+            renderParams.occlusionMeshId = !innerPass && hasMultipleViews ? GetOcclusionMesh(eye, renderParams.projection) : 0;
+            renderParams.viewportRect = GetViewportRect(eye, frameHints);
+        }
+
+        if (hasMultipleViews)
+        {
+            GetCombinedCullingPass(nextFrame.cullingPasses[0]);
+        }
+        else
+        {
+            auto& cullingPass = nextFrame.cullingPasses[0];
+            cullingPass.deviceAnchorToCullingPose = GetPose(0);
+            cullingPass.projection = GetProjection(0);
+            cullingPass.separation = 0.0f;
+        }
+    }
+    else if (!singlePassRendering)
     {
         // Use multi-pass rendering to render
 
@@ -165,99 +432,144 @@ UnitySubsystemErrorCode WebXRDisplayProvider::GfxThread_PopulateNextFrameDesc(co
             auto& renderPass = nextFrame.renderPasses[pass];
 
             // Texture that unity will render to next frame.  We created it above.
-            // You might want to change this dynamically to double / triple buffer.
-#if !SIDE_BY_SIDE
-            renderPass.textureId = m_UnityTextures[pass];
-#else
-            renderPass.textureId = m_UnityTextures[0];
-#endif
+            renderPass.textureId = GetPassTexture(pass, layerTexture);
 
             // One set of render params per pass.
             renderPass.renderParamsCount = 1;
 
-            // Note that you can share culling between multiple passes by setting this to the same index.
-            renderPass.cullingPassIndex = pass;
+            // Both eyes share one combined culling pass, so the scene is culled once per frame.
+            renderPass.cullingPassIndex = 0;
 
             // Fill out render params. View, projection, viewport for pass.
-            auto& cullingPass = nextFrame.cullingPasses[pass];
-            cullingPass.separation = fabs(s_PoseXPositionPerPass[1]) + fabs(s_PoseXPositionPerPass[0]);
-
             auto& renderParams = renderPass.renderParams[0];
-            renderParams.deviceAnchorToEyePose = cullingPass.deviceAnchorToCullingPose = GetPose(pass);
-            renderParams.projection = cullingPass.projection = GetProjection(pass);
-
-#if !SIDE_BY_SIDE
-            // App has hinted that it would like to render to a smaller viewport.  Tell unity to render to that viewport.
-            renderParams.viewportRect = frameHints.appSetup.renderViewport;
-
-            // Tell the compositor what pixels were rendered to for display.
-            // Compositor_SetRenderSubRect(pass, renderParams.viewportRect);
-#else
-            // TODO: frameHints.appSetup.renderViewport
-            renderParams.viewportRect = {
-                pass == 0 ? 0.0f : 0.5f,        // x
-                0.0f,                           // y
-                hasMultipleViews ? 0.5f : 0.0f, // width
-                1.0f                            // height
-            };
-#endif
+            renderParams.deviceAnchorToEyePose = GetPose(pass);
+            renderParams.projection = GetProjection(pass);
+            renderParams.occlusionMeshId = hasMultipleViews ? GetOcclusionMesh(pass, renderParams.projection) : 0;
+
+            // Unity renders to, and the final blit samples, only this sub-rect of the texture.
+            renderParams.viewportRect = GetViewportRect(pass, frameHints);
+        }
+
+        if (hasMultipleViews)
+        {
+            GetCombinedCullingPass(nextFrame.cullingPasses[0]);
+        }
+        else
+        {
+            auto& cullingPass = nextFrame.cullingPasses[0];
+            cullingPass.deviceAnchorToCullingPose = GetPose(0);
+            cullingPass.projection = GetProjection(0);
+            cullingPass.separation = 0.0f;
         }
     }
     else
     {
-        // Example of using single-pass stereo to combine the first two render passes.
+        // Single-pass stereo combines both eyes into one render pass.
         nextFrame.renderPassesCount = NUM_RENDER_PASSES - 1;
 
-        UnityXRNextFrameDesc::UnityXRRenderPass& renderPass = nextFrame.renderPasses[0];
-
-        // Texture that unity will render to next frame.  We created it above.
-        // You might want to change this dynamically to double / triple buffer.
-        renderPass.textureId = m_UnityTextures[0];
-
-        // Two sets of render params for first pass, view / projection for each eye.  Fill them out next.
-        renderPass.renderParamsCount = 2;
-
-        for (int eye = 0; eye < 2; ++eye)
+        // Two sets of render params, view / projection for each eye, into the texture we created above.
+        // Side by side textures hold both views, texture arrays one view per slice.
+        WebXRSinglePassEye eyes[WebXRSinglePass::kEyesCount];
+        for (int eye = 0; eye < WebXRSinglePass::kEyesCount; ++eye)
         {
-            UnityXRNextFrameDesc::UnityXRRenderPass::UnityXRRenderParams& renderParams = renderPass.renderParams[eye];
-            renderParams.deviceAnchorToEyePose = GetPose(eye);
-            renderParams.projection = GetProjection(eye);
-
-#if SIDE_BY_SIDE
-            // TODO: frameHints.appSetup.renderViewport
-            renderParams.viewportRect = {
-                eye == 0 ? 0.0f : 0.5f, // x
-                0.0f,                   // y
-                0.5f,                   // width
-                1.0f                    // height
-            };
-#else
-            // Each eye goes to different texture array slices.
-            renderParams.textureArraySlice = eye;
-#endif
+            eyes[eye].pose = GetPose(eye);
+            eyes[eye].projection = GetProjection(eye);
+            eyes[eye].occlusionMeshId = GetOcclusionMesh(eye, eyes[eye].projection);
         }
+        WebXRSinglePass::Fill(m_ViewLayout, textureLayout, GetPassTexture(0, layerTexture),
+            eyes, GetRenderViewport(frameHints), m_ResolutionGovernor.GetScale(), nextFrame.renderPasses[0]);
 
-        renderPass.cullingPassIndex = 0;
-
-        // TODO: set up culling pass to use a combine frustum
-        auto& cullingPass = nextFrame.cullingPasses[0];
-        cullingPass.deviceAnchorToCullingPose = GetPose(0);
-        cullingPass.projection = GetProjection(0);
-        cullingPass.separation = 0.625f;
+        GetCombinedCullingPass(nextFrame.cullingPasses[0]);
     }
 
+    m_CachedFrameDesc = nextFrame;
+    m_FrameDescDirtyFlags = 0;
+
+    // The spectator pose follows the app every frame, it's never part of the cached frame descriptor.
+    AppendSpectatorPass(nextFrame);
+
     return kUnitySubsystemErrorCodeSuccess;
 }
 
 UnitySubsystemErrorCode WebXRDisplayProvider::GfxThread_Stop()
 {
+    // Keep the textures in the pool, the next session usually needs the same ones.
+    ReleaseTextures();
+    DestroyOcclusionMeshes();
+    m_GpuTimer.Shutdown();
+    m_FrameDescDirtyFlags = kFrameDescDirtyAll;
+    m_CachedFrameDesc.renderPassesCount = 0;
     WORKAROUND_RESET_SKIP_FIRST_FRAME();
     return kUnitySubsystemErrorCodeSuccess;
 }
 
-UnitySubsystemErrorCode WebXRDisplayProvider::GfxThread_FinalBlitToGameViewBackBuffer(const UnityXRMirrorViewBlitInfo* mirrorBlitInfo, WebXRProviderContext& ctx)
+// Copies the spectator pass, or the eye views in s_CanvasMirrorMode, to the page canvas.
+// Unity's mirror view target is the XRWebGLLayer framebuffer, Unity blits the eye views there from
+// QueryMirrorViewBlitDesc. The canvas drawing buffer has the size of that framebuffer during XR sessions,
+// it's Unity's screen size, so the copy fills it at that size: a smaller copy would need a second blit
+// to cover the canvas.
+void WebXRDisplayProvider::GfxThread_BlitToCanvas()
 {
-    return UnitySubsystemErrorCode::kUnitySubsystemErrorCodeSuccess;
+    uint32_t textureName = 0;
+    int width = 0;
+    int height = 0;
+    if (m_SpectatorRendered)
+    {
+        m_SpectatorRendered = false;
+        if (GetNativeTexture(m_SpectatorTextureId, &textureName, &width, &height))
+        {
+            WebXRBlitTextureToCanvas(textureName, -1, 0, 0, width, height, 0.0f, 0.0f, 1.0f, 1.0f);
+        }
+        return;
+    }
+
+    // The layer texture belongs to the compositor, it's only the headset view.
+    const UnityXRNextFrameDesc& frame = m_CachedFrameDesc;
+    if (s_CanvasMirrorMode == kWebXRCanvasMirrorNone || frame.renderPassesCount == 0 || renderToLayerTexture)
+    {
+        return;
+    }
+
+    // Eye views in pass order, see QueryMirrorViewBlitDesc. Foveated frames have the whole eye views
+    // in the outer passes, all in the same texture.
+    int eyesCount = hasMultipleViews ? 2 : 1;
+    bool singlePass = frame.renderPassesCount == 1 && frame.renderPasses[0].renderParamsCount == 2;
+    UnityXRRectf eyeRects[WebXRCanvasMirror::kMaxBlits];
+    for (int eye = 0; eye < eyesCount; ++eye)
+    {
+        eyeRects[eye] = frame.renderPasses[singlePass ? 0 : eye].renderParams[singlePass ? eye : 0].viewportRect;
+    }
+
+    if (!GetNativeTexture(frame.renderPasses[0].textureId, &textureName, &width, &height))
+    {
+        return;
+    }
+    WebXRCanvasMirrorBlit blits[WebXRCanvasMirror::kMaxBlits];
+    int blitsCount = WebXRCanvasMirror::GetBlits(s_CanvasMirrorMode, eyeRects, eyesCount, (float)width / height, WebXRGetCanvasAspect(), blits);
+    for (int i = 0; i < blitsCount; ++i)
+    {
+        const UnityXRRectf& src = blits[i].srcRect;
+        const UnityXRRectf& dest = blits[i].destRect;
+        int srcLayer = m_TextureLayout == kWebXRTextureLayoutTextureArray && singlePass ? frame.renderPasses[0].renderParams[blits[i].view].textureArraySlice : -1;
+        WebXRBlitTextureToCanvas(textureName, srcLayer, (int)(src.x * width), (int)(src.y * height), (int)(src.width * width), (int)(src.height * height),
+            dest.x, dest.y, dest.width, dest.height);
+    }
+}
+
+bool WebXRDisplayProvider::GetNativeTexture(UnityXRRenderTextureId textureId, uint32_t* textureName, int* width, int* height)
+{
+    // Unity allocates the textures lazily, their GL names are known only once rendered to.
+    UnityXRRenderTextureDesc desc{};
+    if (textureId == 0
+        || m_Ctx.display->QueryTextureDesc(m_Handle, textureId, &desc) != kUnitySubsystemErrorCodeSuccess
+        || desc.color.nativePtr == NULL || desc.width == 0 || desc.height == 0)
+    {
+        return false;
+    }
+    *textureName = (uint32_t)(uintptr_t)desc.color.nativePtr;
+    *width = (int)desc.width;
+    *height = (int)desc.height;
+    return true;
 }
 
 void WebXRDisplayProvider::Stop()
@@ -266,47 +578,259 @@ void WebXRDisplayProvider::Stop()
 
 void WebXRDisplayProvider::Shutdown()
 {
+    ReleaseTextures();
+    m_TexturePool.Clear();
 }
 
-void WebXRDisplayProvider::CreateTextures(int numTextures, int textureArrayLength, float requestedTextureScale)
+void WebXRDisplayProvider::GetTexturePoolStats(uint32_t* hits, uint32_t* misses)
 {
-    const int texWidth = (int)(SIDE_BY_SIDE ? frameBufferWidth : viewWidth);
-    const int texHeight = (int)(SIDE_BY_SIDE ? frameBufferHeight : viewHeight);
+    *hits = m_TexturePool.GetHits();
+    *misses = m_TexturePool.GetMisses();
+}
 
-    m_UnityTextures.resize(numTextures);
+void WebXRDisplayProvider::GetDisplayStats(int* droppedFrameCount, int* framePresentCount, float* refreshRate, float* motionToPhoton, float* gpuFrameTime)
+{
+    *droppedFrameCount = m_StatsReporter.GetDroppedFrameCount();
+    *framePresentCount = m_StatsReporter.GetFramePresentCount();
+    *refreshRate = m_StatsReporter.GetRefreshRate();
+    *motionToPhoton = m_StatsReporter.GetMotionToPhoton();
+    *gpuFrameTime = m_GpuTimer.GetFrameTime();
+}
+
+void WebXRDisplayProvider::GfxThread_BeginGpuTimerPass()
+{
+    m_GpuTimer.BeginPass(m_GpuTimerPassEvents++);
+}
+
+void WebXRDisplayProvider::CreateTextures(WebXRTextureLayout textureLayout, float requestedTextureScale)
+{
+    if (requestedTextureScale <= 0.0f)
+    {
+        requestedTextureScale = 1.0f;
+    }
+    m_TextureScale = requestedTextureScale;
+
+    // Side by side textures cover only the bounding rect of the views, not the padding around them.
+    // Texture array slices are as large as the largest view.
+    const int numTextures = 1;
+    const int texWidth = (int)(m_ViewLayout.GetTextureWidth(textureLayout) * requestedTextureScale);
+    const int texHeight = (int)(m_ViewLayout.GetTextureHeight(textureLayout) * requestedTextureScale);
+    const int textureArrayLength = m_ViewLayout.GetTextureArrayLength(textureLayout);
 
     // Tell unity about the native textures, getting back UnityXRRenderTextureIds.
+    m_UnityTextures.resize(numTextures);
     for (int i = 0; i < numTextures; ++i)
     {
-        UnityXRRenderTextureDesc uDesc{};
-        // Example of telling Unity to create the texture.  You can later obtain the native texture resource with
-        // QueryTextureDesc
-        uDesc.color.nativePtr = (void*)kUnityXRRenderTextureIdDontCare;
-        uDesc.width = texWidth;
-        uDesc.height = texHeight;
-        uDesc.textureArrayLength = textureArrayLength;
+        m_UnityTextures[i] = AcquireTexture(texWidth, texHeight, textureArrayLength);
+    }
+}
+
+void WebXRDisplayProvider::CreateFoveatedTextures(float requestedTextureScale)
+{
+    if (requestedTextureScale <= 0.0f)
+    {
+        requestedTextureScale = 1.0f;
+    }
+    m_TextureScale = requestedTextureScale;
+
+    // Both textures hold the eyes in the views layout. The outer one covers the whole eye views at a reduced
+    // resolution, the inner one only the inner views, at the full resolution.
+    float outerScale = requestedTextureScale * s_FoveatedOuterScale;
+    float innerScale = requestedTextureScale * s_FoveatedInnerSize;
+    float texWidth = (float)m_ViewLayout.GetTextureWidth();
+    float texHeight = (float)m_ViewLayout.GetTextureHeight();
+
+    m_UnityTextures.resize(2);
+    m_UnityTextures[0] = AcquireTexture((int)(texWidth * outerScale), (int)(texHeight * outerScale), 0);
+    m_UnityTextures[1] = AcquireTexture((int)(texWidth * innerScale), (int)(texHeight * innerScale), 0);
+}
+
+UnityXRRenderTextureId WebXRDisplayProvider::AcquireTexture(int width, int height, int textureArrayLength)
+{
+    UnityXRRenderTextureDesc uDesc{};
+    // Example of telling Unity to create the texture.  You can later obtain the native texture resource with
+    // QueryTextureDesc
+    uDesc.colorFormat = m_ColorFormat;
+    uDesc.color.nativePtr = (void*)kUnityXRRenderTextureIdDontCare;
+    uDesc.depthFormat = m_DepthFormat;
+    uDesc.depth.nativePtr = (void*)kUnityXRRenderTextureIdDontCare;
+    uDesc.width = width;
+    uDesc.height = height;
+    uDesc.textureArrayLength = textureArrayLength;
+    uDesc.flags = m_TextureFlags;
+
+    // Get an UnityXRRenderTextureId from the pool, it creates one only if no free texture matches.
+    return m_TexturePool.Acquire(uDesc);
+}
 
-        // Create an UnityXRRenderTextureId for the native texture so we can tell unity to render to it later.
-        UnityXRRenderTextureId uTexId;
-        m_Ctx.display->CreateTexture(m_Handle, &uDesc, &uTexId);
-        UnityXRVector2 size;
-        size.x = texWidth;
-        size.x = texHeight;
-        m_UnityTextures[i] = uTexId;
+// Picks the eye textures formats from the app hints. Returns true when they changed.
+bool WebXRDisplayProvider::UpdateTextureFormats(const UnityXRFrameSetupHints& frameHints)
+{
+    // RGB565 has no alpha, transparent sessions (AR) keep RGBA32 to blend with the camera feed.
+    bool use16BitColor = frameHints.appSetup.use16BitColorBuffers && !transparentBackground;
+    UnityXRRenderTextureFormat colorFormat = use16BitColor ? kUnityXRRenderTextureFormatRGB565 : kUnityXRRenderTextureFormatRGBA32;
+    // With 16 bit color, 16 bit depth keeps the bandwidth savings. It has no stencil either.
+    UnityXRDepthTextureFormat depthFormat = use16BitColor ? kUnityXRDepthTextureFormat16bit : kUnityXRDepthTextureFormat24bitOrGreater;
+    uint32_t textureFlags = frameHints.appSetup.sRGB ? kUnityXRRenderTextureFlagsSRGB : 0;
+
+    if (colorFormat == m_ColorFormat && depthFormat == m_DepthFormat && textureFlags == m_TextureFlags)
+    {
+        return false;
     }
+    m_ColorFormat = colorFormat;
+    m_DepthFormat = depthFormat;
+    m_TextureFlags = textureFlags;
+    return true;
 }
 
-void WebXRDisplayProvider::DestroyTextures()
+void WebXRDisplayProvider::ReleaseTextures()
 {
-    for (int i = 0; i < m_UnityTextures.size(); ++i)
+    for (auto textureId : m_UnityTextures)
     {
-        if (m_UnityTextures[i] != 0)
+        if (textureId != 0)
         {
-            m_Ctx.display->DestroyTexture(m_Handle, m_UnityTextures[i]);
+            m_TexturePool.Release(textureId);
         }
     }
-
     m_UnityTextures.clear();
+
+    if (m_LayerTextureId != 0)
+    {
+        m_TexturePool.Release(m_LayerTextureId);
+    }
+    m_LayerTextureId = 0;
+    m_LayerTextureName = 0;
+
+    if (m_SpectatorTextureId != 0)
+    {
+        m_TexturePool.Release(m_SpectatorTextureId);
+    }
+    m_SpectatorTextureId = 0;
+    m_SpectatorTextureWidth = 0;
+    m_SpectatorTextureHeight = 0;
+    m_SpectatorRendered = false;
+}
+
+void WebXRDisplayProvider::AppendSpectatorPass(UnityXRNextFrameDesc& nextFrame)
+{
+    // Foveated frames already use all the render passes.
+    int pass = nextFrame.renderPassesCount;
+    if (!m_SpectatorView.IsEnabled() || pass == 0 || pass >= kUnityXRMaxNumRenderPasses)
+    {
+        return;
+    }
+
+    int width = m_SpectatorView.GetTextureWidth(m_ViewLayout.GetTextureHeight());
+    int height = m_SpectatorView.GetTextureHeight(m_ViewLayout.GetTextureHeight());
+    if (width != m_SpectatorTextureWidth || height != m_SpectatorTextureHeight || m_SpectatorTextureId == 0)
+    {
+        if (m_SpectatorTextureId != 0)
+        {
+            m_TexturePool.Release(m_SpectatorTextureId);
+        }
+        m_SpectatorTextureId = AcquireTexture(width, height, 0);
+        m_SpectatorTextureWidth = width;
+        m_SpectatorTextureHeight = height;
+    }
+    if (m_SpectatorTextureId == 0)
+    {
+        return;
+    }
+
+    auto& renderPass = nextFrame.renderPasses[pass];
+    renderPass.textureId = m_SpectatorTextureId;
+    renderPass.renderParamsCount = 1;
+
+    auto& renderParams = renderPass.renderParams[0];
+    renderParams.deviceAnchorToEyePose = m_SpectatorView.GetPose();
+    renderParams.projection = m_SpectatorView.GetProjection(GetProjection(0).data.matrix);
+    renderParams.occlusionMeshId = 0;
+    renderParams.textureArraySlice = 0;
+    renderParams.viewportRect = {0.0f, 0.0f, 1.0f, 1.0f};
+
+    // Inside the eyes frustum, the eyes culling pass covers the spectator too.
+    if (m_SpectatorView.IsInsideCullingPass(nextFrame.cullingPasses[0], renderParams.projection.data.matrix))
+    {
+        renderPass.cullingPassIndex = 0;
+    }
+    else
+    {
+        renderPass.cullingPassIndex = 1;
+        auto& cullingPass = nextFrame.cullingPasses[1];
+        cullingPass.deviceAnchorToCullingPose = renderParams.deviceAnchorToEyePose;
+        cullingPass.projection = renderParams.projection;
+        cullingPass.separation = 0.0f;
+    }
+
+    nextFrame.renderPassesCount = pass + 1;
+    m_SpectatorRendered = true;
+}
+
+UnityXRRenderTextureId WebXRDisplayProvider::GetLayerTexture()
+{
+    uint32_t textureName = (uint32_t)m_Ctx.frameSnapshot.viewsData[58];
+    if (textureName == m_LayerTextureName)
+    {
+        return m_LayerTextureId;
+    }
+
+    // The layer swaps between a few textures, the pool keeps a Unity texture for each of them.
+    if (m_LayerTextureId != 0)
+    {
+        m_TexturePool.Release(m_LayerTextureId);
+    }
+
+    UnityXRRenderTextureDesc uDesc{};
+    uDesc.color.nativePtr = (void*)(uintptr_t)textureName;
+    uDesc.width = (uint32_t)frameBufferWidth;
+    uDesc.height = (uint32_t)frameBufferHeight;
+    m_LayerTextureId = textureName != 0 ? m_TexturePool.Acquire(uDesc) : 0;
+    m_LayerTextureName = textureName;
+    return m_LayerTextureId;
+}
+
+UnityXRRectf WebXRDisplayProvider::GetViewportRect(int pass, const UnityXRFrameSetupHints& frameHints)
+{
+    // Area of the texture that belongs to this view. The layer texture is the whole framebuffer,
+    // the eye textures only the bounding rect of the views.
+    UnityXRRectf eyeRect = m_ViewLayout.GetViewRect(pass, m_TextureLayout);
+
+    // App has hinted that it would like to render to a smaller viewport (XRSettings.renderViewportScale),
+    // and the governor may shrink it further. Both are applied inside the allocated texture.
+    return WebXRViewLayout::GetRenderRect(eyeRect, GetRenderViewport(frameHints), m_ResolutionGovernor.GetScale());
+}
+
+UnityXRRectf WebXRDisplayProvider::GetRenderViewport(const UnityXRFrameSetupHints& frameHints)
+{
+    UnityXRRectf renderViewport = frameHints.appSetup.renderViewport;
+    if (renderViewport.width <= 0.0f || renderViewport.height <= 0.0f)
+    {
+        renderViewport = {0.0f, 0.0f, 1.0f, 1.0f};
+    }
+    return renderViewport;
+}
+
+void WebXRDisplayProvider::UpdateFrameTiming()
+{
+    auto now = std::chrono::steady_clock::now();
+    if (m_HasFrameTiming)
+    {
+        float frameInterval = std::chrono::duration<float, std::milli>(now - m_FrameStartTime).count();
+        float frameWork = std::chrono::duration<float, std::milli>(m_FrameSubmitTime - m_FrameStartTime).count();
+        m_ResolutionGovernor.AddFrame(frameInterval, frameWork);
+
+        // The GPU time is a few frames old, still the best hint of GPU bound frames.
+        float gpuWork = m_GpuTimer.GetFrameTime() * 1000.0f;
+        float refreshRate = m_StatsReporter.GetRefreshRate();
+        float framePeriod = refreshRate > 0.0f ? 1000.0f / refreshRate : m_ResolutionGovernor.GetFramePeriod();
+        float currentFrameRate = m_Ctx.frameSnapshot.viewsData[62];
+        if (m_PerformancePolicy.AddFrame(frameInterval, frameWork > gpuWork ? frameWork : gpuWork, framePeriod, currentFrameRate, !m_ResolutionGovernor.IsAtMinScale()))
+        {
+            m_PerformanceChanged = true;
+        }
+    }
+    m_FrameStartTime = m_FrameSubmitTime = now;
+    m_HasFrameTiming = true;
 }
 
 UnityXRPose WebXRDisplayProvider::GetPose(int pass)
@@ -325,41 +849,410 @@ UnityXRPose WebXRDisplayProvider::GetPose(int pass)
 
 UnityXRProjection WebXRDisplayProvider::GetProjection(int pass)
 {
-    UnityXRProjection ret;
-    ret.type = kUnityXRProjectionTypeMatrix;
-    int start = pass * 16;
-    ret.data.matrix.columns[0].x = *(m_ViewsDataArray + start);
-    ret.data.matrix.columns[0].y = *(m_ViewsDataArray + start + 1);
-    ret.data.matrix.columns[0].z = *(m_ViewsDataArray + start + 2);
-    ret.data.matrix.columns[0].w = *(m_ViewsDataArray + start + 3);
-    ret.data.matrix.columns[1].x = *(m_ViewsDataArray + start + 4);
-    ret.data.matrix.columns[1].y = *(m_ViewsDataArray + start + 5);
-    ret.data.matrix.columns[1].z = *(m_ViewsDataArray + start + 6);
-    ret.data.matrix.columns[1].w = *(m_ViewsDataArray + start + 7);
-    ret.data.matrix.columns[2].x = *(m_ViewsDataArray + start + 8);
-    ret.data.matrix.columns[2].y = *(m_ViewsDataArray + start + 9);
-    ret.data.matrix.columns[2].z = *(m_ViewsDataArray + start + 10);
-    ret.data.matrix.columns[2].w = *(m_ViewsDataArray + start + 11);
-    ret.data.matrix.columns[3].x = *(m_ViewsDataArray + start + 12);
-    ret.data.matrix.columns[3].y = *(m_ViewsDataArray + start + 13);
-    ret.data.matrix.columns[3].z = *(m_ViewsDataArray + start + 14);
-    ret.data.matrix.columns[3].w = *(m_ViewsDataArray + start + 15);
-    return ret;
+    return m_Projections[pass];
+}
+
+void WebXRDisplayProvider::UpdateDirtyFlags(const UnityXRFrameSetupHints& frameHints, bool singlePassRendering, bool reallocateTextures)
+{
+    const float* viewsData = m_Ctx.frameSnapshot.viewsData;
+
+    // Projections only change with the device or the depth range, compare the raw matrices.
+    if ((m_FrameDescDirtyFlags & kFrameDescDirtyProjections) != 0
+        || memcmp(m_CachedProjectionsData, viewsData, sizeof(m_CachedProjectionsData)) != 0)
+    {
+        UpdateProjections(viewsData);
+    }
+
+    // Eye positions move with the head, only the distance between them matters here.
+    UpdateEyePoses(viewsData);
+
+    float viewportScale = m_ResolutionGovernor.GetScale();
+    if (reallocateTextures
+        || singlePassRendering != m_CachedSinglePassRendering
+        || viewportScale != m_CachedViewportScale
+        || (kUnityXRFrameSetupHintsChangedRenderViewport & frameHints.changedFlags) != 0)
+    {
+        m_FrameDescDirtyFlags |= kFrameDescDirtyLayout;
+    }
+    m_CachedSinglePassRendering = singlePassRendering;
+    m_CachedViewportScale = viewportScale;
+}
+
+void WebXRDisplayProvider::UpdateEyePoses(const float* viewsData)
+{
+    float viewsHalfDistance = 0.0f;
+    if (hasMultipleViews)
+    {
+        float dx = *(viewsData + 40) - *(viewsData + 43);
+        float dy = *(viewsData + 41) - *(viewsData + 44);
+        float dz = *(viewsData + 42) - *(viewsData + 45);
+        viewsHalfDistance = 0.5f * sqrtf(dx * dx + dy * dy + dz * dz);
+    }
+
+    if (m_EyeHalfDistance >= 0.0f && fabsf(viewsHalfDistance - m_EyeHalfDistance) < EYE_DISTANCE_EPSILON)
+    {
+        return;
+    }
+    m_EyeHalfDistance = viewsHalfDistance;
+    s_PoseXPositionPerPass[0] = -viewsHalfDistance;
+    s_PoseXPositionPerPass[1] = viewsHalfDistance;
+    m_FrameDescDirtyFlags |= kFrameDescDirtyEyePoses;
+}
+
+void WebXRDisplayProvider::UpdateProjections(const float* viewsData)
+{
+    memcpy(m_CachedProjectionsData, viewsData, sizeof(m_CachedProjectionsData));
+    for (int pass = 0; pass < NUM_RENDER_PASSES; ++pass)
+    {
+        // Both are column major, the matrix is copied as is.
+        UnityXRProjection& projection = m_Projections[pass];
+        projection.type = kUnityXRProjectionTypeMatrix;
+        memcpy(&projection.data.matrix, viewsData + pass * 16, sizeof(UnityXRMatrix4x4));
+
+        if (foveatedRendering)
+        {
+            m_InnerRects[pass] = WebXRFoveation::GetInnerRect(projection.data.matrix, s_FoveatedInnerSize);
+            m_InnerProjections[pass].type = kUnityXRProjectionTypeMatrix;
+            m_InnerProjections[pass].data.matrix = WebXRFoveation::GetSubProjection(projection.data.matrix, m_InnerRects[pass]);
+        }
+    }
+    m_FrameDescDirtyFlags |= kFrameDescDirtyProjections;
+}
+
+UnityXRRenderTextureId WebXRDisplayProvider::GetPassTexture(int pass, UnityXRRenderTextureId layerTexture)
+{
+    if (m_FoveatedFrame)
+    {
+        // Outer and inner side by side textures, see CreateFoveatedTextures.
+        int eyesCount = hasMultipleViews ? 2 : 1;
+        return m_UnityTextures[pass < eyesCount ? 0 : 1];
+    }
+    // Every other pass renders to its part of the same texture, or to its slice of the texture array.
+    return renderToLayerTexture ? layerTexture : m_UnityTextures[0];
+}
+
+void WebXRDisplayProvider::PatchCachedFrameDesc(UnityXRRenderTextureId layerTexture, UnityXRNextFrameDesc& nextFrame)
+{
+    nextFrame.renderPassesCount = m_CachedFrameDesc.renderPassesCount;
+    for (int pass = 0; pass < m_CachedFrameDesc.renderPassesCount; ++pass)
+    {
+        nextFrame.renderPasses[pass] = m_CachedFrameDesc.renderPasses[pass];
+        // The projection layer swaps textures between frames.
+        nextFrame.renderPasses[pass].textureId = GetPassTexture(pass, layerTexture);
+        // The mirror view blit reads the textures of the last frame from the cache.
+        m_CachedFrameDesc.renderPasses[pass].textureId = nextFrame.renderPasses[pass].textureId;
+    }
+    nextFrame.cullingPasses[0] = m_CachedFrameDesc.cullingPasses[0];
+}
+
+UnityXROcclusionMeshId WebXRDisplayProvider::GetOcclusionMesh(int pass, const UnityXRProjection& projection)
+{
+    UnityXROcclusionMeshId& meshId = m_OcclusionMeshIds[pass];
+    UnityXRMatrix4x4& meshProjection = m_OcclusionMeshProjections[pass];
+
+    // Rebuild only when the eye projection changed since the mesh was built.
+    if (meshId != 0 && memcmp(&meshProjection, &projection.data.matrix, sizeof(UnityXRMatrix4x4)) == 0)
+    {
+        return meshId;
+    }
+
+    if (meshId == 0 && m_Ctx.display->CreateOcclusionMesh(m_Handle, WebXROcclusionMesh::kNumVertices, WebXROcclusionMesh::kNumIndices, &meshId) != kUnitySubsystemErrorCodeSuccess)
+    {
+        meshId = 0;
+        return 0;
+    }
+
+    meshProjection = projection.data.matrix;
+    m_OcclusionMesh.Build(meshProjection);
+    m_Ctx.display->SetOcclusionMesh(m_Handle, meshId, m_OcclusionMesh.vertices, WebXROcclusionMesh::kNumVertices, m_OcclusionMesh.indices, WebXROcclusionMesh::kNumIndices);
+    return meshId;
+}
+
+void WebXRDisplayProvider::DestroyOcclusionMeshes()
+{
+    for (int pass = 0; pass < NUM_RENDER_PASSES; ++pass)
+    {
+        if (m_OcclusionMeshIds[pass] != 0)
+        {
+            m_Ctx.display->DestroyOcclusionMesh(m_Handle, m_OcclusionMeshIds[pass]);
+            m_OcclusionMeshIds[pass] = 0;
+        }
+    }
+}
+
+// Tangents of the half angles of an OpenGL style projection matrix.
+static UnityXRProjectionHalfAngles GetHalfAngles(const UnityXRMatrix4x4& matrix)
+{
+    UnityXRProjectionHalfAngles halfAngles;
+    halfAngles.left = (matrix.columns[2].x - 1.0f) / matrix.columns[0].x;
+    halfAngles.right = (matrix.columns[2].x + 1.0f) / matrix.columns[0].x;
+    halfAngles.bottom = (matrix.columns[2].y - 1.0f) / matrix.columns[1].y;
+    halfAngles.top = (matrix.columns[2].y + 1.0f) / matrix.columns[1].y;
+    return halfAngles;
+}
+
+void WebXRDisplayProvider::GetCombinedCullingPass(UnityXRNextFrameDesc::UnityXRCullingPass& cullingPass)
+{
+    UnityXRProjection leftProjection = GetProjection(0);
+    UnityXRProjection rightProjection = GetProjection(1);
+    UnityXRProjectionHalfAngles left = GetHalfAngles(leftProjection.data.matrix);
+    UnityXRProjectionHalfAngles right = GetHalfAngles(rightProjection.data.matrix);
+
+    UnityXRProjectionHalfAngles combined;
+    combined.left = fmin(left.left, right.left);
+    combined.right = fmax(left.right, right.right);
+    combined.bottom = fmin(left.bottom, right.bottom);
+    combined.top = fmax(left.top, right.top);
+
+    // Move the culling origin back until the outer planes of the combined frustum
+    // pass through the outer eye positions, so it encloses both eye frustums.
+    float leftEyeX = s_PoseXPositionPerPass[0];
+    float rightEyeX = s_PoseXPositionPerPass[1];
+    float separation = fabs(rightEyeX - leftEyeX);
+    float offsetZ = -separation / (combined.right - combined.left);
+
+    cullingPass.deviceAnchorToCullingPose = GetPose(0);
+    cullingPass.deviceAnchorToCullingPose.position.x = leftEyeX + combined.left * offsetZ;
+    cullingPass.deviceAnchorToCullingPose.position.z = offsetZ;
+    cullingPass.separation = separation;
+
+    // Keep the eye near/far planes, pushed back by the same offset to avoid popping at the edges.
+    const UnityXRMatrix4x4& eye = leftProjection.data.matrix;
+    float nearPlane = eye.columns[3].z / (eye.columns[2].z - 1.0f) - offsetZ;
+    float farPlane = eye.columns[3].z / (eye.columns[2].z + 1.0f) - offsetZ;
+
+    UnityXRProjection& projection = cullingPass.projection;
+    projection.type = kUnityXRProjectionTypeMatrix;
+    projection.data.matrix = {};
+    projection.data.matrix.columns[0].x = 2.0f / (combined.right - combined.left);
+    projection.data.matrix.columns[1].y = 2.0f / (combined.top - combined.bottom);
+    projection.data.matrix.columns[2].x = (combined.right + combined.left) / (combined.right - combined.left);
+    projection.data.matrix.columns[2].y = (combined.top + combined.bottom) / (combined.top - combined.bottom);
+    projection.data.matrix.columns[2].z = -(farPlane + nearPlane) / (farPlane - nearPlane);
+    projection.data.matrix.columns[2].w = -1.0f;
+    projection.data.matrix.columns[3].z = -2.0f * farPlane * nearPlane / (farPlane - nearPlane);
+}
+
+UnitySubsystemErrorCode WebXRDisplayProvider::QueryMirrorViewBlitDesc(const UnityXRMirrorViewBlitInfo& mirrorBlitInfo, UnityXRMirrorViewBlitDesc& blitDescriptor)
+{
+    blitDescriptor.nativeBlitAvailable = false;
+    blitDescriptor.nativeBlitInvalidStates = false;
+    blitDescriptor.blitParamsCount = 0;
+
+    // Nothing rendered yet, or the frame went directly to the layer texture.
+    if (mirrorBlitInfo.mirrorBlitMode == kUnityXRMirrorBlitNone || m_CachedFrameDesc.renderPassesCount == 0 || renderToLayerTexture)
+    {
+        return kUnitySubsystemErrorCodeSuccess;
+    }
+
+    // Each view samples only the viewport Unity rendered to, see GetViewportRect.
+    WebXRMirrorBlit::GetBlitDesc(m_CachedFrameDesc, mirrorBlitInfo.mirrorBlitMode, m_ViewLayout, m_FoveatedFrame ? m_InnerRects : NULL, blitDescriptor);
+    return kUnitySubsystemErrorCodeSuccess;
 }
 
 UnitySubsystemErrorCode WebXRDisplayProvider::UpdateDisplayState(UnityXRDisplayState * state)
 {
     state->displayIsTransparent = transparentBackground;
+
+    // Compositor changes are applied from the main thread, once per frame at most.
+    if (m_PerformanceChanged)
+    {
+        float foveationLevel = m_PerformancePolicy.GetFoveationLevel();
+        if (foveationLevel != m_AppliedFoveationLevel)
+        {
+            WebXRApplyFixedFoveation(foveationLevel);
+            m_AppliedFoveationLevel = foveationLevel;
+        }
+        float targetFrameRate = m_PerformancePolicy.GetTargetFrameRate();
+        if (targetFrameRate > 0.0f && targetFrameRate != m_AppliedTargetFrameRate)
+        {
+            WebXRApplyTargetFrameRate(targetFrameRate);
+            m_AppliedTargetFrameRate = targetFrameRate;
+        }
+        m_PerformanceChanged = false;
+    }
     return kUnitySubsystemErrorCodeSuccess;
 }
 
+void WebXRDisplayProvider::SetAutomaticPerformance(bool enabled)
+{
+    m_PerformancePolicy.SetEnabled(enabled);
+}
+
+void WebXRDisplayProvider::SetFixedFoveation(float level)
+{
+    m_PerformancePolicy.SetFoveationLevel(level);
+    m_PerformanceChanged = true;
+}
+
+float WebXRDisplayProvider::GetFixedFoveation()
+{
+    return m_AppliedFoveationLevel;
+}
+
+void WebXRDisplayProvider::SetTargetFrameRate(float frameRate)
+{
+    m_PerformancePolicy.SetTargetFrameRate(frameRate);
+    m_PerformanceChanged = true;
+}
+
+float WebXRDisplayProvider::GetTargetFrameRate()
+{
+    return m_PerformancePolicy.GetTargetFrameRate();
+}
+
+int WebXRDisplayProvider::GetSupportedFrameRates(float* frameRates, int maxCount)
+{
+    return m_PerformancePolicy.GetSupportedFrameRates(frameRates, maxCount);
+}
+
+void WebXRDisplayProvider::SetSpectatorView(bool enabled, const UnityXRPose& pose, float fieldOfView, float aspect, float resolutionScale)
+{
+    m_SpectatorView.Set(enabled, pose, fieldOfView, aspect, resolutionScale);
+}
+
 // Binding to C-API below here
 
+static WebXRProviderContext* s_DisplayContext{};
+
+extern "C" void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API WebXRGetTexturePoolStats(uint32_t* hits, uint32_t* misses)
+{
+    *hits = 0;
+    *misses = 0;
+    if (s_DisplayContext != NULL && s_DisplayContext->displayProvider != NULL)
+    {
+        s_DisplayContext->displayProvider->GetTexturePoolStats(hits, misses);
+    }
+}
+
+extern "C" void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API WebXRGetDisplayStats(int* droppedFrameCount, int* framePresentCount,
+    float* refreshRate, float* motionToPhoton, float* gpuFrameTime)
+{
+    *droppedFrameCount = 0;
+    *framePresentCount = 0;
+    *refreshRate = 0.0f;
+    *motionToPhoton = 0.0f;
+    *gpuFrameTime = 0.0f;
+    if (s_DisplayContext != NULL && s_DisplayContext->displayProvider != NULL)
+    {
+        s_DisplayContext->displayProvider->GetDisplayStats(droppedFrameCount, framePresentCount, refreshRate, motionToPhoton, gpuFrameTime);
+    }
+}
+
+// Render event for GL.IssuePluginEvent, issued by WebXRManager before each render pass of the XR camera.
+// Passes are rendered in the order of the frame descriptor, so the events count them.
+static void UNITY_INTERFACE_API OnGpuTimerPassEvent(int /* eventId */)
+{
+    if (s_DisplayContext != NULL && s_DisplayContext->displayProvider != NULL)
+    {
+        s_DisplayContext->displayProvider->GfxThread_BeginGpuTimerPass();
+    }
+}
+
+typedef void (UNITY_INTERFACE_API * WebXRRenderingEvent)(int eventId);
+
+extern "C" WebXRRenderingEvent UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API WebXRGetGpuTimerPassEventFunc()
+{
+    return OnGpuTimerPassEvent;
+}
+
+extern "C" void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API WebXRSetSinglePassTextureArray(bool enabled)
+{
+    s_SinglePassTextureArrayEnabled = enabled;
+}
+
+extern "C" void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API WebXRSetFoveatedRendering(bool enabled, float innerSize, float outerScale)
+{
+    s_FoveatedRenderingEnabled = enabled;
+    s_FoveatedInnerSize = innerSize;
+    s_FoveatedOuterScale = outerScale;
+}
+
+extern "C" void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API WebXRSetAutomaticPerformance(bool enabled)
+{
+    s_AutomaticPerformanceEnabled = enabled;
+    if (s_DisplayContext != NULL && s_DisplayContext->displayProvider != NULL)
+    {
+        s_DisplayContext->displayProvider->SetAutomaticPerformance(enabled);
+    }
+}
+
+extern "C" void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API WebXRSetFixedFoveation(float level)
+{
+    s_FixedFoveation = level;
+    if (s_DisplayContext != NULL && s_DisplayContext->displayProvider != NULL)
+    {
+        s_DisplayContext->displayProvider->SetFixedFoveation(level);
+    }
+}
+
+extern "C" float UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API WebXRGetFixedFoveation()
+{
+    if (s_DisplayContext != NULL && s_DisplayContext->displayProvider != NULL)
+    {
+        return s_DisplayContext->displayProvider->GetFixedFoveation();
+    }
+    return s_FixedFoveation > 0.0f ? s_FixedFoveation : 0.0f;
+}
+
+extern "C" void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API WebXRSetTargetFrameRate(float frameRate)
+{
+    s_TargetFrameRate = frameRate;
+    if (s_DisplayContext != NULL && s_DisplayContext->displayProvider != NULL)
+    {
+        s_DisplayContext->displayProvider->SetTargetFrameRate(frameRate);
+    }
+}
+
+extern "C" float UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API WebXRGetTargetFrameRate()
+{
+    if (s_DisplayContext != NULL && s_DisplayContext->displayProvider != NULL)
+    {
+        return s_DisplayContext->displayProvider->GetTargetFrameRate();
+    }
+    return 0.0f;
+}
+
+extern "C" int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API WebXRGetSupportedFrameRates(float* frameRates, int maxCount)
+{
+    if (s_DisplayContext != NULL && s_DisplayContext->displayProvider != NULL)
+    {
+        return s_DisplayContext->displayProvider->GetSupportedFrameRates(frameRates, maxCount);
+    }
+    return 0;
+}
+
+extern "C" void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API WebXRSetCanvasMirrorMode(int mode)
+{
+    s_CanvasMirrorMode = mode;
+}
+
+extern "C" void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API WebXRSetSpectatorView(bool enabled,
+    float positionX, float positionY, float positionZ,
+    float rotationX, float rotationY, float rotationZ, float rotationW,
+    float fieldOfView, float aspect, float resolutionScale)
+{
+    if (s_DisplayContext != NULL && s_DisplayContext->displayProvider != NULL)
+    {
+        UnityXRPose pose;
+        pose.position = {positionX, positionY, positionZ};
+        pose.rotation = {rotationX, rotationY, rotationZ, rotationW};
+        s_DisplayContext->displayProvider->SetSpectatorView(enabled, pose, fieldOfView, aspect, resolutionScale);
+    }
+}
+
+extern "C" void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API WebXRSetDynamicResolution(bool enabled, float minScale)
+{
+    s_DynamicResolutionEnabled = enabled;
+    s_DynamicResolutionMinScale = minScale;
+}
+
 static UnitySubsystemErrorCode UNITY_INTERFACE_API Display_Initialize(UnitySubsystemHandle handle, void* userData)
 {
     auto& ctx = GetWebXRProviderContext(userData);
 
     ctx.displayProvider = new WebXRDisplayProvider(ctx, handle);
+    s_DisplayContext = &ctx;
 
     // Register for callbacks on the graphics thread.
     UnityXRDisplayGraphicsThreadProvider gfxThreadProvider{};
@@ -385,11 +1278,6 @@ static UnitySubsystemErrorCode UNITY_INTERFACE_API Display_Initialize(UnitySubsy
         return ctx.displayProvider->GfxThread_Stop();
     };
 
-    gfxThreadProvider.BlitToMirrorViewRenderTarget = [](UnitySubsystemHandle handle, void* userData, const UnityXRMirrorViewBlitInfo mirrorBlitInfo) -> UnitySubsystemErrorCode {
-        auto& ctx = GetWebXRProviderContext(userData);
-        return ctx.displayProvider->GfxThread_FinalBlitToGameViewBackBuffer(&mirrorBlitInfo, ctx);
-    };
-
     ctx.display->RegisterProviderForGraphicsThread(handle, &gfxThreadProvider);
 
     UnityXRDisplayProvider provider{&ctx, NULL, NULL};
@@ -399,6 +1287,11 @@ static UnitySubsystemErrorCode UNITY_INTERFACE_API Display_Initialize(UnitySubsy
         return ctx.displayProvider->UpdateDisplayState(state);
     };
 
+    provider.QueryMirrorViewBlitDesc = [](UnitySubsystemHandle handle, void* userData, const UnityXRMirrorViewBlitInfo mirrorBlitInfo, UnityXRMirrorViewBlitDesc* blitDescriptor) -> UnitySubsystemErrorCode {
+        auto& ctx = GetWebXRProviderContext(userData);
+        return ctx.displayProvider->QueryMirrorViewBlitDesc(mirrorBlitInfo, *blitDescriptor);
+    };
+
     ctx.display->RegisterProvider(handle, &provider);
 
     return ctx.displayProvider->Initialize();
@@ -410,6 +1303,9 @@ UnitySubsystemErrorCode Load_Display(WebXRProviderContext& ctx)
     if (ctx.display == NULL)
         return kUnitySubsystemErrorCodeFailure;
 
+    // Optional, the display works without stats.
+    ctx.stats = ctx.interfaces->Get<IUnityXRStats>();
+
     UnityLifecycleProvider displayLifecycleHandler{};
     displayLifecycleHandler.userData = &ctx;
     displayLifecycleHandler.Initialize = &Display_Initialize;
@@ -428,6 +1324,7 @@ UnitySubsystemErrorCode Load_Display(WebXRProviderContext& ctx)
         auto& ctx = GetWebXRProviderContext(userData);
         ctx.displayProvider->Shutdown();
         delete ctx.displayProvider;
+        ctx.displayProvider = NULL;
     };
 
     return ctx.display->RegisterLifecycleProvider("WebXR Export", "WebXR Display", &displayLifecycleHandler);
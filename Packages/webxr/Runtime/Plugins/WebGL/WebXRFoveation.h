@@ -0,0 +1,75 @@
+#pragma once
+
+#include "UnityHeaders/UnityXRTypes.h"
+
+// Splits an eye view for fixed foveated rendering: a full resolution inner view around the
+// projection center, and the whole eye view rendered at a reduced resolution underneath.
+// Has no Unity runtime dependencies so the projection math can be checked on the host.
+struct WebXRFoveation
+{
+    // Rect of the inner view, normalized to the eye viewport, innerSize wide and high.
+    // Centered on the view direction and kept inside the viewport, so asymmetric eye
+    // projections get their inner view off center.
+    static UnityXRRectf GetInnerRect(const UnityXRMatrix4x4& eyeProjection, float innerSize)
+    {
+        innerSize = innerSize < 0.0f ? 0.0f : (innerSize > 1.0f ? 1.0f : innerSize);
+
+        // The view direction (0, 0, -1) lands at -columns[2] in normalized device coordinates.
+        float centerX = 0.5f * (1.0f - eyeProjection.columns[2].x);
+        float centerY = 0.5f * (1.0f - eyeProjection.columns[2].y);
+
+        UnityXRRectf rect;
+        rect.width = innerSize;
+        rect.height = innerSize;
+        rect.x = ClampStart(centerX - 0.5f * innerSize, innerSize);
+        rect.y = ClampStart(centerY - 0.5f * innerSize, innerSize);
+        return rect;
+    }
+
+    // Off-axis projection that maps the rect of the eye viewport to the whole viewport.
+    // Applied in clip space, so the depth mapping of the eye projection is kept as is.
+    static UnityXRMatrix4x4 GetSubProjection(const UnityXRMatrix4x4& eyeProjection, const UnityXRRectf& rect)
+    {
+        // Rect edges in normalized device coordinates.
+        float left = 2.0f * rect.x - 1.0f;
+        float right = 2.0f * (rect.x + rect.width) - 1.0f;
+        float bottom = 2.0f * rect.y - 1.0f;
+        float top = 2.0f * (rect.y + rect.height) - 1.0f;
+
+        // x' = scaleX * x + offsetX * w, same for y.
+        float scaleX = 2.0f / (right - left);
+        float offsetX = -(right + left) / (right - left);
+        float scaleY = 2.0f / (top - bottom);
+        float offsetY = -(top + bottom) / (top - bottom);
+
+        UnityXRMatrix4x4 projection = eyeProjection;
+        for (int column = 0; column < 4; ++column)
+        {
+            const UnityXRVector4& eyeColumn = eyeProjection.columns[column];
+            projection.columns[column].x = scaleX * eyeColumn.x + offsetX * eyeColumn.w;
+            projection.columns[column].y = scaleY * eyeColumn.y + offsetY * eyeColumn.w;
+        }
+        return projection;
+    }
+
+    // Rect of the inner view inside another rect, like the eye area of the mirror view.
+    static UnityXRRectf GetRectInside(const UnityXRRectf& outer, const UnityXRRectf& rect)
+    {
+        UnityXRRectf inside;
+        inside.x = outer.x + rect.x * outer.width;
+        inside.y = outer.y + rect.y * outer.height;
+        inside.width = rect.width * outer.width;
+        inside.height = rect.height * outer.height;
+        return inside;
+    }
+
+private:
+    static float ClampStart(float start, float size)
+    {
+        if (start < 0.0f)
+        {
+            return 0.0f;
+        }
+        return start + size > 1.0f ? 1.0f - size : start;
+    }
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+// Estimates the display refresh period from the intervals between frame starts, for browsers that
+// don't expose XRSession.frameRate. The period is the shortest interval seen, re-estimated every
+// window so a refresh rate change is picked up. Late frames never lengthen it.
+// Has no Unity or browser dependencies so it can be fed recorded frame-time traces.
+class WebXRFramePeriodEstimator
+{
+public:
+    void Reset()
+    {
+        m_Period = 0.0f;
+        m_WindowMinInterval = 0.0f;
+        m_WindowFrames = 0;
+    }
+
+    // frameInterval is the time between two frame starts, in milliseconds.
+    void AddInterval(float frameInterval)
+    {
+        if (frameInterval <= 0.0f)
+        {
+            return;
+        }
+        if (m_WindowFrames == 0 || frameInterval < m_WindowMinInterval)
+        {
+            m_WindowMinInterval = frameInterval;
+        }
+        if (m_Period <= 0.0f || frameInterval < m_Period)
+        {
+            m_Period = frameInterval;
+        }
+        if (++m_WindowFrames >= kWindowFrames)
+        {
+            m_Period = m_WindowMinInterval;
+            m_WindowFrames = 0;
+        }
+    }
+
+    // In milliseconds, 0 until the first interval.
+    float GetPeriod() const { return m_Period; }
+
+    static const int kWindowFrames = 90;
+
+private:
+    float m_Period = 0.0f;
+    float m_WindowMinInterval = 0.0f;
+    int m_WindowFrames = 0;
+};
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstring>
+
+// Copy of the views data block of one XR frame, shared by the display and tracking providers.
+// webxr.jspre stamps the block with the XR frame number after writing the views, whichever
+// provider runs first in a Unity frame latches it, so render and input always use the same XR frame.
+struct WebXRFrameSnapshot
+{
+    // Projections, views poses, viewports, views count, is transparent, framebuffer size,
+    // projection layer texture, frame number, frame time, predicted display time and refresh rate.
+    static const int kViewsDataLength = 63;
+    static const int kFrameNumberIndex = 59;
+
+    float viewsData[kViewsDataLength] = {};
+    int frameNumber = -1;
+
+    // Returns true when a newer XR frame was latched.
+    bool Latch(const float* viewsDataArray)
+    {
+        int latestFrameNumber = (int)viewsDataArray[kFrameNumberIndex];
+        if (latestFrameNumber == frameNumber)
+        {
+            return false;
+        }
+        memcpy(viewsData, viewsDataArray, sizeof(viewsData));
+        frameNumber = latestFrameNumber;
+        return true;
+    }
+};
@@ -0,0 +1,204 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Timer queries used by WebXRGpuTimer. Implemented with WebGL disjoint timer queries in
+// WebXRGpuTimerGL.h, any other implementation can replace it to feed recorded or fake timings.
+class WebXRGpuTimerBackend
+{
+public:
+    virtual ~WebXRGpuTimerBackend() {}
+
+    virtual bool IsAvailable() = 0;
+    virtual uint32_t CreateQuery() = 0;
+    virtual void DeleteQuery(uint32_t query) = 0;
+    // Only one query can be active at a time.
+    virtual void BeginQuery(uint32_t query) = 0;
+    virtual void EndQuery() = 0;
+    virtual bool IsResultAvailable(uint32_t query) = 0;
+    // Elapsed GPU time in nanoseconds.
+    virtual uint64_t GetResult(uint32_t query) = 0;
+    // True when the GPU timings of the pending queries are unreliable, like after a power state change.
+    virtual bool IsDisjoint() = 0;
+};
+
+// GPU time of the app frames, from the frame setup to the submit, with a per render pass breakdown.
+// Each pass of a frame has its own query, keyed by the pass index: BeginFrame starts pass 0 and
+// BeginPass ends the running pass query and starts the next one. Unity renders the passes without
+// calling the display provider in between, so BeginPass is driven by render events issued from
+// the app before each pass. Without them, the whole frame is counted as pass 0.
+// Results are read a few frames later, only when already available, so it never stalls.
+class WebXRGpuTimer
+{
+public:
+    static const int kFramesInFlight = 4;
+    static const int kMaxPasses = 8;
+
+    void Initialize(WebXRGpuTimerBackend* backend)
+    {
+        m_Backend = backend;
+        m_Enabled = m_Backend != NULL && m_Backend->IsAvailable();
+    }
+
+    void Shutdown()
+    {
+        if (m_Backend != NULL)
+        {
+            if (m_ActivePass >= 0)
+            {
+                m_Backend->EndQuery();
+            }
+            for (int frame = 0; frame < kFramesInFlight; ++frame)
+            {
+                for (int pass = 0; pass < kMaxPasses; ++pass)
+                {
+                    uint32_t& query = m_Frames[frame].queries[pass];
+                    if (query != 0)
+                    {
+                        m_Backend->DeleteQuery(query);
+                        query = 0;
+                    }
+                }
+            }
+        }
+        for (int frame = 0; frame < kFramesInFlight; ++frame)
+        {
+            m_Frames[frame].pending = false;
+        }
+        m_ActivePass = -1;
+        m_Enabled = false;
+        m_Backend = NULL;
+    }
+
+    bool IsEnabled() const { return m_Enabled; }
+
+    void BeginFrame()
+    {
+        if (!m_Enabled || m_ActivePass >= 0)
+        {
+            return;
+        }
+        Frame& frame = m_Frames[m_FrameIndex];
+        // All slots still wait for the GPU, skip this frame instead of waiting.
+        if (frame.pending)
+        {
+            return;
+        }
+        frame.passesCount = 0;
+        StartPass(frame, 0);
+    }
+
+    // Called before the pass is rendered. Passes only move forward, an index at or before the running pass is ignored.
+    void BeginPass(int pass)
+    {
+        if (m_ActivePass < 0 || pass <= m_ActivePass || pass >= kMaxPasses)
+        {
+            return;
+        }
+        m_Backend->EndQuery();
+        StartPass(m_Frames[m_FrameIndex], pass);
+    }
+
+    void EndFrame()
+    {
+        if (m_ActivePass < 0)
+        {
+            return;
+        }
+        m_Backend->EndQuery();
+        m_Frames[m_FrameIndex].pending = true;
+        m_FrameIndex = (m_FrameIndex + 1) % kFramesInFlight;
+        m_ActivePass = -1;
+    }
+
+    // Reads the results of finished frames, oldest first. Returns true when a new result is available.
+    bool Poll()
+    {
+        if (!m_Enabled)
+        {
+            return false;
+        }
+
+        if (m_Backend->IsDisjoint())
+        {
+            for (int frame = 0; frame < kFramesInFlight; ++frame)
+            {
+                m_Frames[frame].pending = false;
+            }
+            return false;
+        }
+
+        bool hasResult = false;
+        for (int i = 0; i < kFramesInFlight; ++i)
+        {
+            Frame& frame = m_Frames[(m_FrameIndex + i) % kFramesInFlight];
+            if (!frame.pending)
+            {
+                continue;
+            }
+            // Queries finish in order, the last pass of a frame finishes last and the newer frames aren't ready either.
+            if (!m_Backend->IsResultAvailable(frame.queries[frame.passesCount - 1]))
+            {
+                break;
+            }
+            m_FrameTime = 0.0f;
+            for (int pass = 0; pass < kMaxPasses; ++pass)
+            {
+                m_PassTimes[pass] = 0.0f;
+                if (pass < frame.passesCount && frame.measured[pass])
+                {
+                    m_PassTimes[pass] = (float)(m_Backend->GetResult(frame.queries[pass]) * 1e-9);
+                    m_FrameTime += m_PassTimes[pass];
+                }
+            }
+            m_PassesCount = frame.passesCount;
+            frame.pending = false;
+            hasResult = true;
+        }
+        return hasResult;
+    }
+
+    // Times of the last measured frame, in seconds.
+    float GetFrameTime() const { return m_FrameTime; }
+    // 0 for the passes that had no BeginPass in that frame, their time is in the pass before.
+    float GetPassTime(int pass) const { return pass >= 0 && pass < kMaxPasses ? m_PassTimes[pass] : 0.0f; }
+    const float* GetPassTimes() const { return m_PassTimes; }
+    // Index of the last measured pass + 1.
+    int GetPassesCount() const { return m_PassesCount; }
+
+private:
+    struct Frame
+    {
+        uint32_t queries[kMaxPasses] = {};
+        bool measured[kMaxPasses] = {};
+        int passesCount = 0;
+        bool pending = false;
+    };
+
+    void StartPass(Frame& frame, int pass)
+    {
+        for (int skipped = frame.passesCount; skipped < pass; ++skipped)
+        {
+            frame.measured[skipped] = false;
+        }
+        if (frame.queries[pass] == 0)
+        {
+            frame.queries[pass] = m_Backend->CreateQuery();
+        }
+        m_Backend->BeginQuery(frame.queries[pass]);
+        frame.measured[pass] = true;
+        frame.passesCount = pass + 1;
+        m_ActivePass = pass;
+    }
+
+    WebXRGpuTimerBackend* m_Backend = NULL;
+    bool m_Enabled = false;
+    // Pass of the running query, -1 outside of a measured frame.
+    int m_ActivePass = -1;
+    Frame m_Frames[kFramesInFlight];
+    int m_FrameIndex = 0;
+    float m_FrameTime = 0.0f;
+    float m_PassTimes[kMaxPasses] = {};
+    int m_PassesCount = 0;
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "WebXRGpuTimer.h"
+
+#if defined(__EMSCRIPTEN__)
+#include <GLES3/gl3.h>
+#include <emscripten/html5.h>
+
+#ifndef GL_TIME_ELAPSED_EXT
+#define GL_TIME_ELAPSED_EXT 0x88BF
+#endif
+#ifndef GL_GPU_DISJOINT_EXT
+#define GL_GPU_DISJOINT_EXT 0x8FBB
+#endif
+
+// Timer queries of EXT_disjoint_timer_query_webgl2, on the WebGL context Unity renders with.
+class WebXRGpuTimerBackendGL : public WebXRGpuTimerBackend
+{
+public:
+    bool IsAvailable() override
+    {
+        EMSCRIPTEN_WEBGL_CONTEXT_HANDLE context = emscripten_webgl_get_current_context();
+        return context != 0 && emscripten_webgl_enable_extension(context, "EXT_disjoint_timer_query_webgl2");
+    }
+
+    uint32_t CreateQuery() override
+    {
+        GLuint query = 0;
+        glGenQueries(1, &query);
+        return query;
+    }
+
+    void DeleteQuery(uint32_t query) override
+    {
+        GLuint glQuery = query;
+        glDeleteQueries(1, &glQuery);
+    }
+
+    void BeginQuery(uint32_t query) override { glBeginQuery(GL_TIME_ELAPSED_EXT, query); }
+    void EndQuery() override { glEndQuery(GL_TIME_ELAPSED_EXT); }
+
+    bool IsResultAvailable(uint32_t query) override
+    {
+        GLuint available = 0;
+        glGetQueryObjectuiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+        return available != 0;
+    }
+
+    uint64_t GetResult(uint32_t query) override
+    {
+        // WebGL 2 returns the elapsed time as a 32 bits value, enough for a frame.
+        GLuint elapsed = 0;
+        glGetQueryObjectuiv(query, GL_QUERY_RESULT, &elapsed);
+        return elapsed;
+    }
+
+    bool IsDisjoint() override
+    {
+        GLint disjoint = 0;
+        glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+        return disjoint != 0;
+    }
+};
+#else
+// Builds without a WebGL context have no timer queries.
+class WebXRGpuTimerBackendGL : public WebXRGpuTimerBackend
+{
+public:
+    bool IsAvailable() override { return false; }
+    uint32_t CreateQuery() override { return 0; }
+    void DeleteQuery(uint32_t) override {}
+    void BeginQuery(uint32_t) override {}
+    void EndQuery() override {}
+    bool IsResultAvailable(uint32_t) override { return false; }
+    uint64_t GetResult(uint32_t) override { return 0; }
+    bool IsDisjoint() override { return false; }
+};
+#endif
@@ -0,0 +1,108 @@
+#pragma once
+
+struct WebXRHapticPulse
+{
+    // 0 stops the playing pulse.
+    float amplitude;
+    // Milliseconds.
+    float duration;
+};
+
+// Haptic commands of one controller, queued as they are requested and flushed once per XR frame
+// as at most one GamepadHapticActuator.pulse call. A pulse replaces the one playing on the actuator,
+// so overlapping pulses are merged: the strongest amplitude until the latest end.
+// Has no Unity runtime dependencies so command sequences can be checked on the host.
+class WebXRHapticQueue
+{
+public:
+    static const int kCapacity = 16;
+
+    void Clear()
+    {
+        m_Count = 0;
+        m_Amplitude = 0.0f;
+        m_PlayingUntil = 0.0;
+    }
+
+    // duration in milliseconds. A full queue merges the pulse into the last command.
+    void Pulse(float amplitude, float duration)
+    {
+        if (amplitude <= 0.0f || duration <= 0.0f)
+        {
+            return;
+        }
+        amplitude = amplitude < 1.0f ? amplitude : 1.0f;
+        if (m_Count == kCapacity)
+        {
+            Command& last = m_Commands[kCapacity - 1];
+            last.amplitude = last.amplitude > amplitude ? last.amplitude : amplitude;
+            last.duration = last.duration > duration ? last.duration : duration;
+            return;
+        }
+        m_Commands[m_Count++] = {false, amplitude, duration};
+    }
+
+    void Stop()
+    {
+        // Commands before a stop never play.
+        m_Commands[0] = {true, 0.0f, 0.0f};
+        m_Count = 1;
+    }
+
+    bool IsEmpty() const { return m_Count == 0; }
+
+    // time in milliseconds. Returns true with the pulse to send when the queued commands change what plays.
+    bool Flush(double time, WebXRHapticPulse& pulse)
+    {
+        if (m_Count == 0)
+        {
+            return false;
+        }
+        bool changed = false;
+        float amplitude = time < m_PlayingUntil ? m_Amplitude : 0.0f;
+        double until = time < m_PlayingUntil ? m_PlayingUntil : time;
+        for (int i = 0; i < m_Count; ++i)
+        {
+            const Command& command = m_Commands[i];
+            if (command.stop)
+            {
+                changed = changed || amplitude > 0.0f;
+                amplitude = 0.0f;
+                until = time;
+                continue;
+            }
+            double end = time + command.duration;
+            if (command.amplitude <= amplitude && end <= until)
+            {
+                // Covered by the pulse already playing.
+                continue;
+            }
+            amplitude = amplitude > command.amplitude ? amplitude : command.amplitude;
+            until = until > end ? until : end;
+            changed = true;
+        }
+        m_Count = 0;
+        if (!changed)
+        {
+            return false;
+        }
+        m_Amplitude = amplitude;
+        m_PlayingUntil = until;
+        pulse.amplitude = amplitude;
+        pulse.duration = amplitude > 0.0f ? (float)(until - time) : 0.0f;
+        return true;
+    }
+
+private:
+    struct Command
+    {
+        bool stop;
+        float amplitude;
+        float duration;
+    };
+
+    Command m_Commands[kCapacity] = {};
+    int m_Count = 0;
+    float m_Amplitude = 0.0f;
+    double m_PlayingUntil = 0.0;
+};
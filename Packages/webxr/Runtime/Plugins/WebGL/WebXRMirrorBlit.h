@@ -0,0 +1,62 @@
+#pragma once
+
+#include "UnityHeaders/IUnityXRDisplay.h"
+#include "WebXRFoveation.h"
+#include "WebXRViewLayout.h"
+
+// Mirror view blit of an XR frame into the XRWebGLLayer framebuffer. Each view samples only the sub-rect
+// Unity rendered to, its viewportRect shrunk by XRSettings.renderViewportScale and dynamic resolution,
+// and stretches it over the place of the view in the framebuffer, so reduced resolution frames still fill the views.
+// Has no Unity runtime dependencies so the blits of a frame descriptor can be checked on the host.
+struct WebXRMirrorBlit
+{
+    // Views are in pass order, each pass with one set of render params, or one single-pass pass with both eyes.
+    // innerRects are the foveated inner views in each eye, NULL when the frame isn't foveated.
+    static void GetBlitDesc(const UnityXRNextFrameDesc& frame, int mirrorBlitMode, const WebXRViewLayout& viewLayout,
+        const UnityXRRectf* innerRects, UnityXRMirrorViewBlitDesc& blitDescriptor)
+    {
+        blitDescriptor.blitParamsCount = 0;
+        if (mirrorBlitMode == kUnityXRMirrorBlitNone || frame.renderPassesCount == 0)
+        {
+            return;
+        }
+
+        int eyesCount = viewLayout.GetViewsCount();
+        bool singlePass = frame.renderPassesCount == 1 && frame.renderPasses[0].renderParamsCount == 2;
+        // Foveated frames have the outer passes of all eyes, then the inner ones.
+        int viewsCount = innerRects != NULL ? eyesCount * 2 : eyesCount;
+        for (int view = 0; view < viewsCount && blitDescriptor.blitParamsCount < kUnityXRMaxNumUnityXRBlitParams; ++view)
+        {
+            const auto& renderPass = frame.renderPasses[singlePass ? 0 : view];
+            const auto& renderParams = renderPass.renderParams[singlePass ? view : 0];
+            int eye = view % eyesCount;
+
+            UnityXRRectf destRect = {0.0f, 0.0f, 1.0f, 1.0f};
+            if (mirrorBlitMode == kUnityXRMirrorBlitLeftEye || mirrorBlitMode == kUnityXRMirrorBlitRightEye)
+            {
+                int mirrorEye = mirrorBlitMode == kUnityXRMirrorBlitLeftEye ? 0 : 1;
+                if (eyesCount > 1 && eye != mirrorEye)
+                {
+                    continue;
+                }
+            }
+            else
+            {
+                // Where the compositor samples the view, the rest of the framebuffer is never shown.
+                destRect = viewLayout.GetFramebufferRect(eye);
+            }
+
+            // Inner views go over the outer ones, at the same place in the eye view.
+            if (view >= eyesCount)
+            {
+                destRect = WebXRFoveation::GetRectInside(destRect, innerRects[eye]);
+            }
+
+            auto& blitParams = blitDescriptor.blitParams[blitDescriptor.blitParamsCount++];
+            blitParams.srcTexId = renderPass.textureId;
+            blitParams.srcTexArraySlice = singlePass ? renderParams.textureArraySlice : 0;
+            blitParams.srcRect = renderParams.viewportRect;
+            blitParams.destRect = destRect;
+        }
+    }
+};
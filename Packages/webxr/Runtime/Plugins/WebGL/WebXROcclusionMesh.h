@@ -0,0 +1,60 @@
+#pragma once
+#include "UnityHeaders/UnityXRTypes.h"
+
+#include <cmath>
+#include <stdint.h>
+
+// Hidden area mesh built from an eye projection, in normalized viewport coordinates.
+// WebXR doesn't expose the lens shape, so the visible area is approximated with an ellipse
+// centered on the optical axis of the projection, reaching the farthest viewport edges.
+// Only the corners outside of it are covered by the mesh.
+struct WebXROcclusionMesh
+{
+    static const int kSegments = 32;
+    static const uint32_t kNumVertices = kSegments * 2;
+    static const uint32_t kNumIndices = kSegments * 6;
+    static constexpr float kOuterScale = 3.0f;
+
+    UnityXRVector2 vertices[kNumVertices];
+    uint32_t indices[kNumIndices];
+
+    void Build(const UnityXRMatrix4x4& projection)
+    {
+        // Where the optical axis hits the viewport, from the off-axis terms of the projection.
+        float centerX = 0.5f * (1.0f - projection.columns[2].x);
+        float centerY = 0.5f * (1.0f - projection.columns[2].y);
+        float radiusX = fmaxf(centerX, 1.0f - centerX);
+        float radiusY = fmaxf(centerY, 1.0f - centerY);
+
+        for (int i = 0; i < kSegments; ++i)
+        {
+            float angle = 2.0f * (float)M_PI * i / kSegments;
+            float dirX = cosf(angle) * radiusX;
+            float dirY = sinf(angle) * radiusY;
+
+            // The ellipse can pass the near viewport edges when the projection is off-axis.
+            float borderX = dirX > 0.0f ? (1.0f - centerX) / dirX : (dirX < 0.0f ? -centerX / dirX : INFINITY);
+            float borderY = dirY > 0.0f ? (1.0f - centerY) / dirY : (dirY < 0.0f ? -centerY / dirY : INFINITY);
+            float ellipse = fminf(fminf(borderX, borderY), 1.0f);
+
+            UnityXRVector2& inner = vertices[i * 2];
+            inner.x = centerX + dirX * ellipse;
+            inner.y = centerY + dirY * ellipse;
+
+            // Outer ring follows the viewport border. Pushed out far enough then clamped, the rays
+            // closest to the diagonals land on the viewport corners, so the corners are covered.
+            UnityXRVector2& outer = vertices[i * 2 + 1];
+            outer.x = fminf(fmaxf(centerX + dirX * kOuterScale, 0.0f), 1.0f);
+            outer.y = fminf(fmaxf(centerY + dirY * kOuterScale, 0.0f), 1.0f);
+
+            uint32_t next = (uint32_t)((i + 1) % kSegments) * 2;
+            uint32_t* quad = &indices[i * 6];
+            quad[0] = i * 2;
+            quad[1] = i * 2 + 1;
+            quad[2] = next;
+            quad[3] = next;
+            quad[4] = i * 2 + 1;
+            quad[5] = next + 1;
+        }
+    }
+};
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <cmath>
+
+// Trades the compositor fixed foveation and the session target frame rate against frame times.
+// Resolution stays with WebXRResolutionGovernor, the policy steps in only when the governor
+// can't lower it any further. Over budget it raises foveation first, then lowers the frame rate.
+// With headroom it restores the frame rate first, then lowers foveation.
+// Has no Unity or browser dependencies so it can be fed recorded frame-time traces.
+class WebXRPerformancePolicy
+{
+public:
+    static const int kMaxFrameRates = 8;
+
+    // supportedFrameRates is XRSession.supportedFrameRates, in ascending order.
+    // foveationLevel is the fixedFoveation the layer starts with, foveation is raised from there.
+    void Configure(bool enabled, const float* supportedFrameRates, int frameRatesCount, float foveationLevel)
+    {
+        m_Enabled = enabled;
+        m_FrameRatesCount = frameRatesCount < kMaxFrameRates ? frameRatesCount : kMaxFrameRates;
+        for (int i = 0; i < m_FrameRatesCount; ++i)
+        {
+            m_FrameRates[i] = supportedFrameRates[i];
+        }
+        Reset();
+        m_FoveationLevel = foveationLevel < 0.0f ? 0.0f : (foveationLevel > 1.0f ? 1.0f : foveationLevel);
+    }
+
+    void Reset()
+    {
+        m_FoveationLevel = 0.0f;
+        m_FrameRateIndex = -1;
+        m_MaxFrameRateIndex = -1;
+        m_OverBudgetFrames = 0;
+        m_UnderBudgetFrames = 0;
+        m_CooldownFrames = 0;
+    }
+
+    bool IsEnabled() const { return m_Enabled; }
+    void SetEnabled(bool enabled) { m_Enabled = enabled; }
+
+    int GetSupportedFrameRates(float* frameRates, int maxCount) const
+    {
+        int count = m_FrameRatesCount < maxCount ? m_FrameRatesCount : maxCount;
+        for (int i = 0; i < count; ++i)
+        {
+            frameRates[i] = m_FrameRates[i];
+        }
+        return count;
+    }
+
+    float GetFoveationLevel() const { return m_FoveationLevel; }
+
+    // 0 until a frame rate is known.
+    float GetTargetFrameRate() const { return m_FrameRateIndex >= 0 ? m_FrameRates[m_FrameRateIndex] : 0.0f; }
+
+    void SetFoveationLevel(float level)
+    {
+        m_FoveationLevel = level < 0.0f ? 0.0f : (level > 1.0f ? 1.0f : level);
+        m_CooldownFrames = kCooldownFrames;
+    }
+
+    // Picks the closest supported frame rate. The policy doesn't go above it afterwards.
+    void SetTargetFrameRate(float frameRate)
+    {
+        int index = GetClosestFrameRateIndex(frameRate);
+        if (index < 0)
+        {
+            return;
+        }
+        m_FrameRateIndex = index;
+        m_MaxFrameRateIndex = index;
+        m_CooldownFrames = kCooldownFrames;
+    }
+
+    // frameInterval is the time between two frame starts, frameWork the time the app spent on the frame,
+    // framePeriod the current display period, all in milliseconds. currentFrameRate is XRSession.frameRate.
+    // Returns true when the foveation level or the target frame rate changed.
+    bool AddFrame(float frameInterval, float frameWork, float framePeriod, float currentFrameRate, bool canLowerResolution)
+    {
+        if (m_FrameRateIndex < 0 && currentFrameRate > 0.0f)
+        {
+            // Start from the frame rate the browser picked, and never go above it.
+            m_FrameRateIndex = GetClosestFrameRateIndex(currentFrameRate);
+            m_MaxFrameRateIndex = m_FrameRateIndex;
+        }
+
+        if (!m_Enabled || frameInterval <= 0.0f || framePeriod <= 0.0f)
+        {
+            return false;
+        }
+
+        if (m_CooldownFrames > 0)
+        {
+            m_CooldownFrames--;
+            return false;
+        }
+
+        bool late = frameInterval > framePeriod * kLateIntervalRatio;
+        if (late || frameWork > framePeriod * kOverBudgetRatio)
+        {
+            // Lowering the resolution is cheaper to the eye, let the governor do it first.
+            m_OverBudgetFrames = canLowerResolution ? 0 : m_OverBudgetFrames + 1;
+            m_UnderBudgetFrames = 0;
+        }
+        else if (frameWork < framePeriod * kUnderBudgetRatio)
+        {
+            m_UnderBudgetFrames++;
+            m_OverBudgetFrames = 0;
+        }
+        else
+        {
+            m_OverBudgetFrames = 0;
+            m_UnderBudgetFrames = 0;
+        }
+
+        bool changed = false;
+        if (m_OverBudgetFrames >= kOverBudgetFramesToStep)
+        {
+            if (m_FoveationLevel < 1.0f)
+            {
+                SetFoveationLevel(m_FoveationLevel + kFoveationStep);
+                changed = true;
+            }
+            else if (m_FrameRateIndex > 0)
+            {
+                m_FrameRateIndex--;
+                changed = true;
+            }
+        }
+        else if (m_UnderBudgetFrames >= kUnderBudgetFramesToStep)
+        {
+            // A higher frame rate shortens the period, it must still fit there.
+            if (m_FrameRateIndex >= 0 && m_FrameRateIndex < m_MaxFrameRateIndex
+                && frameWork < (1000.0f / m_FrameRates[m_FrameRateIndex + 1]) * kUnderBudgetRatio)
+            {
+                m_FrameRateIndex++;
+                changed = true;
+            }
+            else if (m_FoveationLevel > 0.0f)
+            {
+                SetFoveationLevel(m_FoveationLevel - kFoveationStep);
+                changed = true;
+            }
+        }
+
+        if (changed)
+        {
+            m_OverBudgetFrames = 0;
+            m_UnderBudgetFrames = 0;
+            m_CooldownFrames = kCooldownFrames;
+        }
+        return changed;
+    }
+
+private:
+    int GetClosestFrameRateIndex(float frameRate) const
+    {
+        int closest = -1;
+        float closestDistance = 0.0f;
+        for (int i = 0; i < m_FrameRatesCount; ++i)
+        {
+            float distance = fabsf(m_FrameRates[i] - frameRate);
+            if (closest < 0 || distance < closestDistance)
+            {
+                closest = i;
+                closestDistance = distance;
+            }
+        }
+        return closest;
+    }
+
+    // Slower than the governor, foveation and frame rate changes are more visible.
+    static const int kOverBudgetFramesToStep = 30;
+    static const int kUnderBudgetFramesToStep = 180;
+    static const int kCooldownFrames = 90;
+    static constexpr float kLateIntervalRatio = 1.5f;
+    static constexpr float kOverBudgetRatio = 0.9f;
+    static constexpr float kUnderBudgetRatio = 0.6f;
+    static constexpr float kFoveationStep = 0.25f;
+
+    bool m_Enabled = false;
+    float m_FrameRates[kMaxFrameRates] = {};
+    int m_FrameRatesCount = 0;
+    float m_FoveationLevel = 0.0f;
+    int m_FrameRateIndex = -1;
+    int m_MaxFrameRateIndex = -1;
+    int m_OverBudgetFrames = 0;
+    int m_UnderBudgetFrames = 0;
+    int m_CooldownFrames = 0;
+};
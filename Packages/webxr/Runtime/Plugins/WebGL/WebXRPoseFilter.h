@@ -0,0 +1,82 @@
+#pragma once
+
+#include "UnityHeaders/UnityXRTypes.h"
+#include "WebXRPoseMath.h"
+
+#include <cmath>
+
+struct WebXRPoseFilterParameters
+{
+    // Cutoff frequency at rest, in Hz. Lower removes more jitter, and adds more lag to slow motion.
+    float minCutoff = 1.0f;
+    // Cutoff increase per unit of speed, in m/s for positions and rad/s for rotations. Higher reduces lag in fast motion.
+    float beta = 5.0f;
+    // Cutoff frequency of the speed estimate, in Hz.
+    float derivativeCutoff = 1.0f;
+};
+
+// One Euro filter of one tracked pose: a low-pass filter whose cutoff frequency rises with the speed,
+// so jitter is smoothed at rest while fast motion keeps little lag.
+// Positions and rotations are filtered separately, rotations with slerp.
+// Has no Unity runtime dependencies so it can be fed synthetic pose streams on the host.
+class WebXRPoseFilter
+{
+public:
+    // Frames further apart than this are a tracking gap, the filter restarts from the next pose.
+    static constexpr double kMaxFrameInterval = 100.0;
+
+    void Reset()
+    {
+        m_HasPose = false;
+    }
+
+    bool HasPose() const { return m_HasPose; }
+    // Last filtered pose.
+    const UnityXRPose& GetPose() const { return m_Pose; }
+
+    // time in milliseconds, one pose per XR frame. Returns the filtered pose.
+    const UnityXRPose& Filter(double time, const UnityXRPose& pose, const WebXRPoseFilterParameters& parameters)
+    {
+        double interval = time - m_Time;
+        m_Time = time;
+        if (!m_HasPose || interval <= 0.0 || interval > kMaxFrameInterval)
+        {
+            m_HasPose = true;
+            m_Pose = pose;
+            m_PositionSpeed = m_RotationSpeed = 0.0f;
+            return m_Pose;
+        }
+        float seconds = (float)(interval * 0.001);
+        float derivativeAlpha = Alpha(parameters.derivativeCutoff, seconds);
+
+        float dx = pose.position.x - m_Pose.position.x;
+        float dy = pose.position.y - m_Pose.position.y;
+        float dz = pose.position.z - m_Pose.position.z;
+        float positionSpeed = sqrtf(dx * dx + dy * dy + dz * dz) / seconds;
+        m_PositionSpeed += derivativeAlpha * (positionSpeed - m_PositionSpeed);
+        float alpha = Alpha(parameters.minCutoff + parameters.beta * m_PositionSpeed, seconds);
+        m_Pose.position = WebXRPoseMath::Lerp(m_Pose.position, pose.position, alpha);
+
+        UnityXRVector3 delta = WebXRPoseMath::ToRotationVector(
+            WebXRPoseMath::Multiply(pose.rotation, WebXRPoseMath::Conjugate(m_Pose.rotation)));
+        float rotationSpeed = sqrtf(delta.x * delta.x + delta.y * delta.y + delta.z * delta.z) / seconds;
+        m_RotationSpeed += derivativeAlpha * (rotationSpeed - m_RotationSpeed);
+        alpha = Alpha(parameters.minCutoff + parameters.beta * m_RotationSpeed, seconds);
+        m_Pose.rotation = WebXRPoseMath::Slerp(m_Pose.rotation, pose.rotation, alpha);
+        return m_Pose;
+    }
+
+private:
+    // Smoothing factor of an exponential low-pass filter with the cutoff frequency, for a sample interval.
+    static float Alpha(float cutoff, float seconds)
+    {
+        float tau = 1.0f / (2.0f * 3.14159265f * cutoff);
+        return 1.0f / (1.0f + tau / seconds);
+    }
+
+    bool m_HasPose = false;
+    double m_Time = 0.0;
+    UnityXRPose m_Pose = {};
+    float m_PositionSpeed = 0.0f;
+    float m_RotationSpeed = 0.0f;
+};
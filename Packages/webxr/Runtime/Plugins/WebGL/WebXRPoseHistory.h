@@ -0,0 +1,130 @@
+#pragma once
+
+#include "UnityHeaders/UnityXRTypes.h"
+#include "WebXRPoseMath.h"
+
+#include <atomic>
+#include <stdint.h>
+
+struct WebXRPoseSample
+{
+    // Milliseconds since Unix epoch, like UnityXRTimeStamp, with sub-millisecond precision.
+    double time;
+    UnityXRPose pose;
+};
+
+// Fixed size ring buffer of the poses of one tracked device, one sample per XR frame.
+// A single writer adds samples, readers copy them without locks and retry when the writer
+// overwrote the samples they read. The slot next written is never read, so 63 of the 64 samples
+// are usable, about half a second at 120Hz.
+// Has no Unity runtime dependencies so it can be fed synthetic pose streams on the host.
+class WebXRPoseHistory
+{
+public:
+    static const uint32_t kCapacity = 64;
+
+    void Clear()
+    {
+        m_Count.store(0, std::memory_order_release);
+    }
+
+    // Samples must be added in increasing time order, older ones are ignored.
+    void Add(double time, const UnityXRPose& pose)
+    {
+        uint32_t count = m_Count.load(std::memory_order_relaxed);
+        if (count > 0 && time <= m_Samples[(count - 1) % kCapacity].time)
+        {
+            return;
+        }
+        m_Samples[count % kCapacity] = {time, pose};
+        m_Count.store(count + 1, std::memory_order_release);
+    }
+
+    bool IsEmpty() const { return m_Count.load(std::memory_order_acquire) == 0; }
+
+    bool GetLatest(WebXRPoseSample& sample) const
+    {
+        for (;;)
+        {
+            uint32_t count = m_Count.load(std::memory_order_acquire);
+            if (count == 0)
+            {
+                return false;
+            }
+            sample = m_Samples[(count - 1) % kCapacity];
+            if (IsStillValid(count - 1))
+            {
+                return true;
+            }
+        }
+    }
+
+    // Interpolates the two samples around time, linearly for position and with slerp for rotation.
+    // Times after the newest sample get the newest pose. Returns false for times before the oldest sample.
+    bool Sample(double time, UnityXRPose& pose) const
+    {
+        for (;;)
+        {
+            uint32_t count = m_Count.load(std::memory_order_acquire);
+            if (count == 0)
+            {
+                return false;
+            }
+            uint32_t oldest = count >= kCapacity ? count - kCapacity + 1 : 0;
+            WebXRPoseSample after = m_Samples[(count - 1) % kCapacity];
+            if (time >= after.time)
+            {
+                pose = after.pose;
+                if (IsStillValid(count - 1))
+                {
+                    return true;
+                }
+                continue;
+            }
+            // Binary search of the first sample newer than time.
+            uint32_t low = oldest;
+            uint32_t high = count - 1;
+            while (low < high)
+            {
+                uint32_t middle = low + (high - low) / 2;
+                if (m_Samples[middle % kCapacity].time > time)
+                {
+                    high = middle;
+                }
+                else
+                {
+                    low = middle + 1;
+                }
+            }
+            if (low == oldest)
+            {
+                if (IsStillValid(oldest))
+                {
+                    return false;
+                }
+                continue;
+            }
+            WebXRPoseSample before = m_Samples[(low - 1) % kCapacity];
+            after = m_Samples[low % kCapacity];
+            if (!IsStillValid(low - 1))
+            {
+                continue;
+            }
+            float t = (float)((time - before.time) / (after.time - before.time));
+            pose.position = WebXRPoseMath::Lerp(before.pose.position, after.pose.position, t);
+            pose.rotation = WebXRPoseMath::Slerp(before.pose.rotation, after.pose.rotation, t);
+            return true;
+        }
+    }
+
+private:
+    // True when the writer didn't start overwriting the sample at index while it was read.
+    bool IsStillValid(uint32_t index) const
+    {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return m_Count.load(std::memory_order_relaxed) < index + kCapacity;
+    }
+
+    WebXRPoseSample m_Samples[kCapacity] = {};
+    std::atomic<uint32_t> m_Count{0};
+};
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "UnityHeaders/UnityXRTypes.h"
+
+#include <cmath>
+
+// Vector and quaternion helpers for the tracking provider, in Unity's left-handed space.
+// Has no Unity runtime dependencies so pose streams can be checked on the host.
+namespace WebXRPoseMath
+{
+    inline UnityXRVector3 Lerp(const UnityXRVector3& a, const UnityXRVector3& b, float t)
+    {
+        return {a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t};
+    }
+
+    inline UnityXRVector4 Normalize(const UnityXRVector4& q)
+    {
+        float length = sqrtf(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+        if (length <= 0.0f)
+        {
+            return {0.0f, 0.0f, 0.0f, 1.0f};
+        }
+        float scale = 1.0f / length;
+        return {q.x * scale, q.y * scale, q.z * scale, q.w * scale};
+    }
+
+    // Shortest path, falls back to a normalized lerp when the rotations are nearly equal.
+    inline UnityXRVector4 Slerp(const UnityXRVector4& a, const UnityXRVector4& b, float t)
+    {
+        float cosTheta = a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+        float sign = 1.0f;
+        if (cosTheta < 0.0f)
+        {
+            cosTheta = -cosTheta;
+            sign = -1.0f;
+        }
+        float weightA = 1.0f - t;
+        float weightB = t;
+        if (cosTheta < 0.9995f)
+        {
+            float theta = acosf(cosTheta);
+            float sinTheta = sinf(theta);
+            weightA = sinf((1.0f - t) * theta) / sinTheta;
+            weightB = sinf(t * theta) / sinTheta;
+        }
+        weightB *= sign;
+        return Normalize({a.x * weightA + b.x * weightB,
+                          a.y * weightA + b.y * weightB,
+                          a.z * weightA + b.z * weightB,
+                          a.w * weightA + b.w * weightB});
+    }
+
+    inline UnityXRVector4 Conjugate(const UnityXRVector4& q)
+    {
+        return {-q.x, -q.y, -q.z, q.w};
+    }
+
+    inline UnityXRVector4 Multiply(const UnityXRVector4& a, const UnityXRVector4& b)
+    {
+        return {a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+                a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+                a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+                a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z};
+    }
+
+    // Rotation vector of q, the rotation axis scaled by the angle in radians, along the shortest path.
+    inline UnityXRVector3 ToRotationVector(const UnityXRVector4& q)
+    {
+        float sign = q.w < 0.0f ? -1.0f : 1.0f;
+        float sinHalfAngle = sqrtf(q.x * q.x + q.y * q.y + q.z * q.z);
+        if (sinHalfAngle < 1e-6f)
+        {
+            // Small angles: angle * axis ~ 2 * q.xyz
+            return {2.0f * sign * q.x, 2.0f * sign * q.y, 2.0f * sign * q.z};
+        }
+        float angle = 2.0f * atan2f(sinHalfAngle, sign * q.w);
+        float scale = sign * angle / sinHalfAngle;
+        return {q.x * scale, q.y * scale, q.z * scale};
+    }
+
+    inline UnityXRVector4 FromRotationVector(const UnityXRVector3& v)
+    {
+        float angle = sqrtf(v.x * v.x + v.y * v.y + v.z * v.z);
+        if (angle < 1e-6f)
+        {
+            return Normalize({0.5f * v.x, 0.5f * v.y, 0.5f * v.z, 1.0f});
+        }
+        float scale = sinf(0.5f * angle) / angle;
+        return {v.x * scale, v.y * scale, v.z * scale, cosf(0.5f * angle)};
+    }
+
+    inline UnityXRVector3 Rotate(const UnityXRVector4& q, const UnityXRVector3& v)
+    {
+        // v + 2 * cross(q.xyz, cross(q.xyz, v) + q.w * v)
+        float cx = q.y * v.z - q.z * v.y + q.w * v.x;
+        float cy = q.z * v.x - q.x * v.z + q.w * v.y;
+        float cz = q.x * v.y - q.y * v.x + q.w * v.z;
+        return {v.x + 2.0f * (q.y * cz - q.z * cy),
+                v.y + 2.0f * (q.z * cx - q.x * cz),
+                v.z + 2.0f * (q.x * cy - q.y * cx)};
+    }
+}
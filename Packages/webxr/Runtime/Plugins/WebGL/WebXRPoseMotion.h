@@ -0,0 +1,104 @@
+#pragma once
+
+#include "UnityHeaders/UnityXRTypes.h"
+#include "WebXRPoseMath.h"
+
+// Linear and angular velocity and acceleration of one tracked device, from finite differences
+// of the poses of consecutive XR frames. Angular values are world space rotation vectors, in radians.
+// Has no Unity runtime dependencies so it can be fed synthetic pose streams on the host.
+class WebXRPoseMotion
+{
+public:
+    // Frames further apart than this are a tracking gap, velocities restart from zero after one.
+    static constexpr double kMaxFrameInterval = 100.0;
+    // Longest extrapolation, so a stale predicted display time can't throw the poses away.
+    static constexpr float kMaxPredictionSeconds = 0.05f;
+
+    void Reset()
+    {
+        m_SamplesCount = 0;
+        m_Velocity = m_AngularVelocity = m_Acceleration = m_AngularAcceleration = {};
+    }
+
+    // time in milliseconds, one pose per XR frame.
+    void Add(double time, const UnityXRPose& pose)
+    {
+        double interval = time - m_Time;
+        if (m_SamplesCount > 0 && interval <= 0.0)
+        {
+            return;
+        }
+        if (m_SamplesCount == 0 || interval > kMaxFrameInterval)
+        {
+            m_SamplesCount = 1;
+            m_Velocity = m_AngularVelocity = m_Acceleration = m_AngularAcceleration = {};
+        }
+        else
+        {
+            float inverseSeconds = (float)(1000.0 / interval);
+            UnityXRVector3 velocity = Scale({pose.position.x - m_Pose.position.x,
+                                             pose.position.y - m_Pose.position.y,
+                                             pose.position.z - m_Pose.position.z}, inverseSeconds);
+            UnityXRVector4 delta = WebXRPoseMath::Multiply(pose.rotation, WebXRPoseMath::Conjugate(m_Pose.rotation));
+            UnityXRVector3 angularVelocity = Scale(WebXRPoseMath::ToRotationVector(delta), inverseSeconds);
+            if (m_SamplesCount > 1)
+            {
+                m_Acceleration = Scale(Subtract(velocity, m_Velocity), inverseSeconds);
+                m_AngularAcceleration = Scale(Subtract(angularVelocity, m_AngularVelocity), inverseSeconds);
+            }
+            m_Velocity = velocity;
+            m_AngularVelocity = angularVelocity;
+            if (m_SamplesCount < 3)
+            {
+                ++m_SamplesCount;
+            }
+        }
+        m_Time = time;
+        m_Pose = pose;
+    }
+
+    bool HasVelocity() const { return m_SamplesCount > 1; }
+    bool HasAcceleration() const { return m_SamplesCount > 2; }
+
+    const UnityXRVector3& GetVelocity() const { return m_Velocity; }
+    const UnityXRVector3& GetAngularVelocity() const { return m_AngularVelocity; }
+    const UnityXRVector3& GetAcceleration() const { return m_Acceleration; }
+    const UnityXRVector3& GetAngularAcceleration() const { return m_AngularAcceleration; }
+
+    // Extrapolates pose by seconds, at most kMaxPredictionSeconds, at constant linear and angular velocity.
+    // Accelerations are too noisy at XR frame rates to extrapolate with.
+    UnityXRPose Predict(const UnityXRPose& pose, float seconds) const
+    {
+        if (!HasVelocity() || seconds <= 0.0f)
+        {
+            return pose;
+        }
+        seconds = seconds < kMaxPredictionSeconds ? seconds : kMaxPredictionSeconds;
+        UnityXRPose predicted;
+        predicted.position = {pose.position.x + m_Velocity.x * seconds,
+                              pose.position.y + m_Velocity.y * seconds,
+                              pose.position.z + m_Velocity.z * seconds};
+        UnityXRVector4 delta = WebXRPoseMath::FromRotationVector(Scale(m_AngularVelocity, seconds));
+        predicted.rotation = WebXRPoseMath::Normalize(WebXRPoseMath::Multiply(delta, pose.rotation));
+        return predicted;
+    }
+
+private:
+    static UnityXRVector3 Scale(const UnityXRVector3& v, float scale)
+    {
+        return {v.x * scale, v.y * scale, v.z * scale};
+    }
+
+    static UnityXRVector3 Subtract(const UnityXRVector3& a, const UnityXRVector3& b)
+    {
+        return {a.x - b.x, a.y - b.y, a.z - b.z};
+    }
+
+    int m_SamplesCount = 0;
+    double m_Time = 0.0;
+    UnityXRPose m_Pose = {};
+    UnityXRVector3 m_Velocity = {};
+    UnityXRVector3 m_AngularVelocity = {};
+    UnityXRVector3 m_Acceleration = {};
+    UnityXRVector3 m_AngularAcceleration = {};
+};
@@ -3,6 +3,8 @@
 #include "UnityHeaders/IUnityXRTrace.h"
 #include "UnityHeaders/UnitySubsystemTypes.h"
 
+#include "WebXRFrameSnapshot.h"
+
 #include <cassert>
 
 extern "C"
@@ -13,6 +15,7 @@ extern "C"
 struct IUnityXRTrace;
 struct IUnityXRDisplayInterface;
 struct IUnityXRInputInterface;
+struct IUnityXRStats;
 
 class WebXRDisplayProvider;
 class WebXRTrackingProvider;
@@ -24,9 +27,12 @@ struct WebXRProviderContext
 
     IUnityXRDisplayInterface* display;
     WebXRDisplayProvider* displayProvider;
+    IUnityXRStats* stats;
 
     IUnityXRInputInterface* input;
     WebXRTrackingProvider* trackingProvider;
+
+    WebXRFrameSnapshot frameSnapshot;
 };
 
 inline WebXRProviderContext& GetWebXRProviderContext(void* data)
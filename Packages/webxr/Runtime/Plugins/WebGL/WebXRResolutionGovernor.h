@@ -0,0 +1,114 @@
+#pragma once
+
+#include "WebXRFramePeriodEstimator.h"
+
+// Picks a render scale from frame timings, lowering it when frames run over
+// the display refresh budget and raising it back when there is headroom.
+// Has no Unity or browser dependencies so it can be fed recorded frame-time traces.
+class WebXRResolutionGovernor
+{
+public:
+    void Configure(bool enabled, float minScale, float maxScale)
+    {
+        m_Enabled = enabled;
+        m_MinScale = minScale;
+        m_MaxScale = maxScale;
+        Reset();
+    }
+
+    void Reset()
+    {
+        m_Scale = m_MaxScale;
+        m_FramePeriod.Reset();
+        m_OverBudgetFrames = 0;
+        m_UnderBudgetFrames = 0;
+        m_CooldownFrames = 0;
+    }
+
+    bool IsEnabled() const { return m_Enabled; }
+    float GetScale() const { return m_Enabled ? m_Scale : 1.0f; }
+    bool IsAtMinScale() const { return !m_Enabled || m_Scale <= m_MinScale; }
+    float GetFramePeriod() const { return m_FramePeriod.GetPeriod(); }
+
+    // frameInterval is the time between two frame starts, frameWork the time the app spent
+    // between frame start and submit, both in milliseconds.
+    // Returns true when the scale changed.
+    bool AddFrame(float frameInterval, float frameWork)
+    {
+        if (!m_Enabled || frameInterval <= 0.0f)
+        {
+            return false;
+        }
+
+        m_FramePeriod.AddInterval(frameInterval);
+        float framePeriod = m_FramePeriod.GetPeriod();
+        if (framePeriod <= 0.0f)
+        {
+            return false;
+        }
+
+        if (m_CooldownFrames > 0)
+        {
+            m_CooldownFrames--;
+            return false;
+        }
+
+        // A late frame shows as an interval of two periods or more, work alone can miss it
+        // when the browser blocks outside of the Unity frame.
+        bool late = frameInterval > framePeriod * kLateIntervalRatio;
+        if (late || frameWork > framePeriod * kOverBudgetRatio)
+        {
+            m_OverBudgetFrames++;
+            m_UnderBudgetFrames = 0;
+        }
+        else if (frameWork < framePeriod * kUnderBudgetRatio)
+        {
+            m_UnderBudgetFrames++;
+            m_OverBudgetFrames = 0;
+        }
+        else
+        {
+            m_OverBudgetFrames = 0;
+            m_UnderBudgetFrames = 0;
+        }
+
+        float scale = m_Scale;
+        if (m_OverBudgetFrames >= kOverBudgetFramesToDrop)
+        {
+            scale = m_Scale - kScaleStep;
+        }
+        else if (m_UnderBudgetFrames >= kUnderBudgetFramesToRaise)
+        {
+            scale = m_Scale + kScaleStep;
+        }
+        scale = scale < m_MinScale ? m_MinScale : (scale > m_MaxScale ? m_MaxScale : scale);
+
+        if (scale == m_Scale)
+        {
+            return false;
+        }
+        m_Scale = scale;
+        m_OverBudgetFrames = 0;
+        m_UnderBudgetFrames = 0;
+        m_CooldownFrames = kCooldownFrames;
+        return true;
+    }
+
+private:
+    static const int kOverBudgetFramesToDrop = 3;
+    static const int kUnderBudgetFramesToRaise = 45;
+    static const int kCooldownFrames = 15;
+    static constexpr float kLateIntervalRatio = 1.5f;
+    static constexpr float kOverBudgetRatio = 0.9f;
+    static constexpr float kUnderBudgetRatio = 0.65f;
+    static constexpr float kScaleStep = 0.1f;
+
+    bool m_Enabled = false;
+    float m_MinScale = 0.5f;
+    float m_MaxScale = 1.0f;
+    float m_Scale = 1.0f;
+    WebXRFramePeriodEstimator m_FramePeriod;
+    int m_OverBudgetFrames = 0;
+    int m_UnderBudgetFrames = 0;
+    int m_CooldownFrames = 0;
+};
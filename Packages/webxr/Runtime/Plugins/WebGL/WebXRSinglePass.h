@@ -0,0 +1,41 @@
+#pragma once
+
+#include "UnityHeaders/IUnityXRDisplay.h"
+#include "WebXRViewLayout.h"
+
+// View of one eye in a single-pass render pass.
+struct WebXRSinglePassEye
+{
+    UnityXRPose pose;
+    UnityXRProjection projection;
+    UnityXROcclusionMeshId occlusionMeshId;
+};
+
+// Single-pass stereo render pass, both eyes rendered by one pass into one texture.
+// Side by side and framebuffer layouts put the views at their place in the texture,
+// the texture array layout renders each view into its slice.
+// Has no Unity runtime dependencies so the frame descriptors of each layout can be checked on the host.
+struct WebXRSinglePass
+{
+    static const int kEyesCount = 2;
+
+    // renderViewport and viewportScale shrink each view, see WebXRViewLayout::GetRenderRect.
+    static void Fill(const WebXRViewLayout& viewLayout, WebXRTextureLayout textureLayout, UnityXRRenderTextureId textureId,
+        const WebXRSinglePassEye* eyes, const UnityXRRectf& renderViewport, float viewportScale,
+        UnityXRNextFrameDesc::UnityXRRenderPass& renderPass)
+    {
+        renderPass.textureId = textureId;
+        renderPass.renderParamsCount = kEyesCount;
+        renderPass.cullingPassIndex = 0;
+
+        for (int eye = 0; eye < kEyesCount; ++eye)
+        {
+            UnityXRNextFrameDesc::UnityXRRenderPass::UnityXRRenderParams& renderParams = renderPass.renderParams[eye];
+            renderParams.deviceAnchorToEyePose = eyes[eye].pose;
+            renderParams.projection = eyes[eye].projection;
+            renderParams.occlusionMeshId = eyes[eye].occlusionMeshId;
+            renderParams.textureArraySlice = viewLayout.GetTextureArraySlice(eye, textureLayout);
+            renderParams.viewportRect = WebXRViewLayout::GetRenderRect(viewLayout.GetViewRect(eye, textureLayout), renderViewport, viewportScale);
+        }
+    }
+};
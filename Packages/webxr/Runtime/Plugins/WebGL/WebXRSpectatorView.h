@@ -0,0 +1,107 @@
+#pragma once
+
+#include "UnityHeaders/IUnityXRDisplay.h"
+#include "WebXRPoseMath.h"
+
+#include <cmath>
+
+// Spectator view rendered as an extra pass of the XR frame, into a reduced resolution texture
+// that webxr.jspre copies to the page canvas. The app sets the pose every frame, in device anchor space.
+// Has no Unity runtime dependencies so the projection and culling math can be checked on the host.
+class WebXRSpectatorView
+{
+public:
+    void Set(bool enabled, const UnityXRPose& pose, float fieldOfView, float aspect, float resolutionScale)
+    {
+        m_Enabled = enabled && fieldOfView > 0.0f && aspect > 0.0f && resolutionScale > 0.0f;
+        m_Pose = pose;
+        m_TanHalfHeight = tanf(0.5f * fieldOfView * kDegreesToRadians);
+        m_TanHalfWidth = m_TanHalfHeight * aspect;
+        m_Aspect = aspect;
+        m_ResolutionScale = resolutionScale > 1.0f ? 1.0f : resolutionScale;
+    }
+
+    bool IsEnabled() const { return m_Enabled; }
+    const UnityXRPose& GetPose() const { return m_Pose; }
+
+    // Texture size for the height of the eye views, in pixels.
+    int GetTextureWidth(float viewHeight) const { return (int)(viewHeight * m_ResolutionScale * m_Aspect + 0.5f); }
+    int GetTextureHeight(float viewHeight) const { return (int)(viewHeight * m_ResolutionScale + 0.5f); }
+
+    // Symmetric projection of the spectator field of view, with the near and far planes of the eye projection.
+    UnityXRProjection GetProjection(const UnityXRMatrix4x4& eyeProjection) const
+    {
+        float nearPlane = eyeProjection.columns[3].z / (eyeProjection.columns[2].z - 1.0f);
+        float farPlane = eyeProjection.columns[3].z / (eyeProjection.columns[2].z + 1.0f);
+
+        UnityXRProjection projection;
+        projection.type = kUnityXRProjectionTypeMatrix;
+        projection.data.matrix = {};
+        projection.data.matrix.columns[0].x = 1.0f / m_TanHalfWidth;
+        projection.data.matrix.columns[1].y = 1.0f / m_TanHalfHeight;
+        projection.data.matrix.columns[2].z = -(farPlane + nearPlane) / (farPlane - nearPlane);
+        projection.data.matrix.columns[2].w = -1.0f;
+        projection.data.matrix.columns[3].z = -2.0f * farPlane * nearPlane / (farPlane - nearPlane);
+        return projection;
+    }
+
+    // True when the spectator frustum stays inside the culling pass of the eyes, so the scene is culled once.
+    // Both frustums are convex, so it's enough that the 8 corners of the spectator frustum, placed by its
+    // pose, are inside the 6 planes of the culling frustum. spectatorProjection is from GetProjection.
+    bool IsInsideCullingPass(const UnityXRNextFrameDesc::UnityXRCullingPass& cullingPass, const UnityXRMatrix4x4& spectatorProjection) const
+    {
+        float nearPlane = spectatorProjection.columns[3].z / (spectatorProjection.columns[2].z - 1.0f);
+        float farPlane = spectatorProjection.columns[3].z / (spectatorProjection.columns[2].z + 1.0f);
+        const UnityXRMatrix4x4& cullingProjection = cullingPass.projection.data.matrix;
+        float cullingNearPlane = cullingProjection.columns[3].z / (cullingProjection.columns[2].z - 1.0f);
+        float cullingFarPlane = cullingProjection.columns[3].z / (cullingProjection.columns[2].z + 1.0f);
+        const UnityXRPose& cullingPose = cullingPass.deviceAnchorToCullingPose;
+        UnityXRVector4 toCullingRotation = WebXRPoseMath::Conjugate(cullingPose.rotation);
+
+        for (int corner = 0; corner < 8; ++corner)
+        {
+            // Unity view space, looking down +z.
+            float depth = corner & 4 ? farPlane : nearPlane;
+            UnityXRVector3 point = {
+                (corner & 1 ? 1.0f : -1.0f) * m_TanHalfWidth * depth,
+                (corner & 2 ? 1.0f : -1.0f) * m_TanHalfHeight * depth,
+                depth};
+
+            // Spectator view to device anchor, then to the culling view.
+            point = WebXRPoseMath::Rotate(m_Pose.rotation, point);
+            point.x += m_Pose.position.x - cullingPose.position.x;
+            point.y += m_Pose.position.y - cullingPose.position.y;
+            point.z += m_Pose.position.z - cullingPose.position.z;
+            point = WebXRPoseMath::Rotate(toCullingRotation, point);
+
+            // Corners on a shared plane, like the near plane of a spectator at the head, count as inside.
+            if (point.z < cullingNearPlane * (1.0f - kPlaneTolerance) || point.z > cullingFarPlane * (1.0f + kPlaneTolerance)
+                || !IsInsideSidePlanes(cullingProjection, point))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    // Left, right, bottom and top planes, in clip space. The projection looks down -z.
+    static bool IsInsideSidePlanes(const UnityXRMatrix4x4& projection, const UnityXRVector3& point)
+    {
+        const UnityXRVector4* c = projection.columns;
+        float clipX = c[0].x * point.x + c[2].x * -point.z;
+        float clipY = c[1].y * point.y + c[2].y * -point.z;
+        float limit = point.z * (1.0f + kPlaneTolerance);
+        return fabsf(clipX) <= limit && fabsf(clipY) <= limit;
+    }
+
+    static constexpr float kDegreesToRadians = 3.14159265f / 180.0f;
+    static constexpr float kPlaneTolerance = 1e-4f;
+
+    bool m_Enabled = false;
+    UnityXRPose m_Pose = {};
+    float m_TanHalfWidth = 1.0f;
+    float m_TanHalfHeight = 1.0f;
+    float m_Aspect = 1.0f;
+    float m_ResolutionScale = 0.5f;
+};
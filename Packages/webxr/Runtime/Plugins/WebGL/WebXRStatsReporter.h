@@ -0,0 +1,160 @@
+#pragma once
+
+#include "UnityHeaders/IUnityXRStats.h"
+#include "UnityHeaders/UnityXRDisplayStats.h"
+
+#include <cmath>
+
+#include "WebXRFramePeriodEstimator.h"
+
+// Per render pass breakdown of kUnityStatsGPUTimeApp, in seconds.
+static const int kWebXRStatsGPUTimePassCount = 8;
+static const char* const kWebXRStatsGPUTimeAppPass[kWebXRStatsGPUTimePassCount] = {
+    "GPUAppLastFrameTimePass0",
+    "GPUAppLastFrameTimePass1",
+    "GPUAppLastFrameTimePass2",
+    "GPUAppLastFrameTimePass3",
+    "GPUAppLastFrameTimePass4",
+    "GPUAppLastFrameTimePass5",
+    "GPUAppLastFrameTimePass6",
+    "GPUAppLastFrameTimePass7"
+};
+
+// Display stats of the XR frames, computed from the frame timestamps webxr.jspre writes
+// with the views, and published to the XRStats C# API (XRStats.TryGetDroppedFrameCount...).
+// Also read from C# with WebXRSubsystem.GetDisplayStats.
+class WebXRStatsReporter
+{
+public:
+    // stats is NULL when the engine has no XR stats interface, the stats are only computed then.
+    void Register(IUnityXRStats* stats, UnitySubsystemHandle handle)
+    {
+        m_Stats = stats;
+        if (m_Stats == NULL || m_Stats->RegisterStatSource(handle) != kUnitySubsystemErrorCodeSuccess)
+        {
+            m_Stats = NULL;
+            return;
+        }
+        m_Stats->RegisterStatDefinition(handle, kUnityStatsDroppedFrameCount, kUnityXRStatOptionNone, &m_DroppedFrameCountStat);
+        m_Stats->RegisterStatDefinition(handle, kUnityStatsFramePresentCount, kUnityXRStatOptionNone, &m_FramePresentCountStat);
+        m_Stats->RegisterStatDefinition(handle, kUnityStatsDisplayRefreshRate, kUnityXRStatOptionNone, &m_DisplayRefreshRateStat);
+        m_Stats->RegisterStatDefinition(handle, kUnityStatsMotionToPhoton, kUnityXRStatOptionNone, &m_MotionToPhotonStat);
+        m_Stats->RegisterStatDefinition(handle, kUnityStatsGPUTimeApp, kUnityXRStatOptionNone, &m_GPUTimeAppStat);
+        for (int pass = 0; pass < kWebXRStatsGPUTimePassCount; ++pass)
+        {
+            m_Stats->RegisterStatDefinition(handle, kWebXRStatsGPUTimeAppPass[pass], kUnityXRStatOptionNone, &m_GPUTimeAppPassStats[pass]);
+        }
+    }
+
+    void Reset()
+    {
+        m_FrameNumber = -1;
+        m_FrameTime = 0.0f;
+        m_FramePeriod = 0.0f;
+        m_FramePeriodEstimator.Reset();
+        m_DroppedFrameCount = 0;
+        m_FramePresentCount = 1;
+        m_MotionToPhoton = 0.0f;
+        m_GPUTimeApp = 0.0f;
+        for (int pass = 0; pass < kWebXRStatsGPUTimePassCount; ++pass)
+        {
+            m_GPUTimeAppPass[pass] = 0.0f;
+        }
+    }
+
+    // frameTime and predictedDisplayTime are in milliseconds since the session started,
+    // predictedDisplayTime is 0 when the browser doesn't expose it.
+    // nominalRefreshRate is XRSession.frameRate, 0 when the browser doesn't expose it.
+    // Returns true when the frame is newer than the last one added.
+    bool AddFrame(int frameNumber, float frameTime, float predictedDisplayTime, float nominalRefreshRate)
+    {
+        if (frameNumber == m_FrameNumber)
+        {
+            return false;
+        }
+
+        float frameInterval = m_FrameNumber >= 0 ? frameTime - m_FrameTime : 0.0f;
+        m_FrameNumber = frameNumber;
+        m_FrameTime = frameTime;
+
+        if (nominalRefreshRate > 0.0f)
+        {
+            m_FramePeriod = 1000.0f / nominalRefreshRate;
+        }
+        else if (frameInterval > 0.0f)
+        {
+            m_FramePeriodEstimator.AddInterval(frameInterval);
+            m_FramePeriod = m_FramePeriodEstimator.GetPeriod();
+        }
+
+        if (m_FramePeriod > 0.0f && frameInterval > 0.0f)
+        {
+            // The browser shows the last frame again on every refresh it doesn't get a new one.
+            int refreshes = (int)floorf(frameInterval / m_FramePeriod + 0.5f);
+            m_FramePresentCount = refreshes > 1 ? refreshes : 1;
+            m_DroppedFrameCount += m_FramePresentCount - 1;
+        }
+
+        // Poses are sampled for the XR frame time, without a predicted display time
+        // assume the frame is shown on the next refresh.
+        float motionToPhoton = predictedDisplayTime > 0.0f ? predictedDisplayTime - frameTime : m_FramePeriod;
+        m_MotionToPhoton = motionToPhoton > 0.0f ? motionToPhoton * 0.001f : 0.0f;
+        return true;
+    }
+
+    // GPU times arrive a few frames late, they're kept as soon as they're read back. In seconds.
+    void AddGpuFrame(float frameTime, const float* passTimes, int passesCount)
+    {
+        m_GPUTimeApp = frameTime;
+        for (int pass = 0; pass < kWebXRStatsGPUTimePassCount; ++pass)
+        {
+            m_GPUTimeAppPass[pass] = pass < passesCount ? passTimes[pass] : 0.0f;
+        }
+    }
+
+    // Sets the stats of the last frame added, once per submitted frame.
+    void Publish()
+    {
+        if (m_Stats == NULL)
+        {
+            return;
+        }
+        m_Stats->SetStatFloat(m_DroppedFrameCountStat, (float)m_DroppedFrameCount);
+        m_Stats->SetStatFloat(m_FramePresentCountStat, (float)m_FramePresentCount);
+        m_Stats->SetStatFloat(m_DisplayRefreshRateStat, GetRefreshRate());
+        m_Stats->SetStatFloat(m_MotionToPhotonStat, m_MotionToPhoton);
+        m_Stats->SetStatFloat(m_GPUTimeAppStat, m_GPUTimeApp);
+        for (int pass = 0; pass < kWebXRStatsGPUTimePassCount; ++pass)
+        {
+            m_Stats->SetStatFloat(m_GPUTimeAppPassStats[pass], m_GPUTimeAppPass[pass]);
+        }
+    }
+
+    // Frames dropped since the session started.
+    int GetDroppedFrameCount() const { return m_DroppedFrameCount; }
+    // Refreshes the previous frame stayed on the display.
+    int GetFramePresentCount() const { return m_FramePresentCount; }
+    float GetRefreshRate() const { return m_FramePeriod > 0.0f ? 1000.0f / m_FramePeriod : 0.0f; }
+    // In seconds, like the other XRStats times.
+    float GetMotionToPhoton() const { return m_MotionToPhoton; }
+
+private:
+    IUnityXRStats* m_Stats = NULL;
+    UnityXRStatId m_DroppedFrameCountStat = NULL;
+    UnityXRStatId m_FramePresentCountStat = NULL;
+    UnityXRStatId m_DisplayRefreshRateStat = NULL;
+    UnityXRStatId m_MotionToPhotonStat = NULL;
+    UnityXRStatId m_GPUTimeAppStat = NULL;
+    UnityXRStatId m_GPUTimeAppPassStats[kWebXRStatsGPUTimePassCount] = {};
+
+    int m_FrameNumber = -1;
+    float m_FrameTime = 0.0f;
+    // From XRSession.frameRate when the browser exposes it, estimated otherwise.
+    float m_FramePeriod = 0.0f;
+    WebXRFramePeriodEstimator m_FramePeriodEstimator;
+    int m_DroppedFrameCount = 0;
+    int m_FramePresentCount = 1;
+    float m_MotionToPhoton = 0.0f;
+    float m_GPUTimeApp = 0.0f;
+    float m_GPUTimeAppPass[kWebXRStatsGPUTimePassCount] = {};
+};
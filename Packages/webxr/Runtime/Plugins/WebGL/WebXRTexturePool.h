@@ -0,0 +1,123 @@
+#pragma once
+#include "UnityHeaders/IUnityXRDisplay.h"
+
+#include <cstring>
+#include <stdint.h>
+#include <vector>
+
+// Keeps the render textures the display provider released, so a later request with the same
+// description (size, formats, array length, flags) reuses the texture instead of allocating.
+// Textures that were not requested for kMaxUnusedFrames frames are destroyed.
+class WebXRTexturePool
+{
+public:
+    static const uint32_t kMaxUnusedFrames = 300;
+
+    void Initialize(IUnityXRDisplayInterface* display, UnitySubsystemHandle handle)
+    {
+        m_Display = display;
+        m_Handle = handle;
+    }
+
+    UnityXRRenderTextureId Acquire(const UnityXRRenderTextureDesc& desc)
+    {
+        for (auto& entry : m_Entries)
+        {
+            if (!entry.inUse && IsSameDesc(entry.desc, desc))
+            {
+                entry.inUse = true;
+                entry.lastUsedFrame = m_Frame;
+                m_Hits++;
+                return entry.textureId;
+            }
+        }
+
+        m_Misses++;
+        UnityXRRenderTextureId textureId = 0;
+        if (m_Display->CreateTexture(m_Handle, &desc, &textureId) != kUnitySubsystemErrorCodeSuccess)
+        {
+            return 0;
+        }
+        Entry entry;
+        entry.desc = desc;
+        entry.textureId = textureId;
+        entry.lastUsedFrame = m_Frame;
+        entry.inUse = true;
+        m_Entries.push_back(entry);
+        return textureId;
+    }
+
+    void Release(UnityXRRenderTextureId textureId)
+    {
+        for (auto& entry : m_Entries)
+        {
+            if (entry.textureId == textureId)
+            {
+                entry.inUse = false;
+                entry.lastUsedFrame = m_Frame;
+                return;
+            }
+        }
+    }
+
+    // Called once per frame, destroys the free textures that were not used recently.
+    void NextFrame()
+    {
+        m_Frame++;
+        for (size_t i = 0; i < m_Entries.size();)
+        {
+            Entry& entry = m_Entries[i];
+            if (!entry.inUse && m_Frame - entry.lastUsedFrame > kMaxUnusedFrames)
+            {
+                m_Display->DestroyTexture(m_Handle, entry.textureId);
+                m_Entries[i] = m_Entries.back();
+                m_Entries.pop_back();
+            }
+            else
+            {
+                ++i;
+            }
+        }
+    }
+
+    void Clear()
+    {
+        for (auto& entry : m_Entries)
+        {
+            m_Display->DestroyTexture(m_Handle, entry.textureId);
+        }
+        m_Entries.clear();
+    }
+
+    uint32_t GetHits() const { return m_Hits; }
+    uint32_t GetMisses() const { return m_Misses; }
+    uint32_t GetTexturesCount() const { return (uint32_t)m_Entries.size(); }
+
+private:
+    struct Entry
+    {
+        UnityXRRenderTextureDesc desc;
+        UnityXRRenderTextureId textureId;
+        uint32_t lastUsedFrame;
+        bool inUse;
+    };
+
+    static bool IsSameDesc(const UnityXRRenderTextureDesc& a, const UnityXRRenderTextureDesc& b)
+    {
+        return a.width == b.width
+            && a.height == b.height
+            && a.colorFormat == b.colorFormat
+            && a.depthFormat == b.depthFormat
+            && a.textureArrayLength == b.textureArrayLength
+            && a.flags == b.flags
+            && memcmp(&a.color, &b.color, sizeof(UnityXRTextureData)) == 0
+            && memcmp(&a.depth, &b.depth, sizeof(UnityXRTextureData)) == 0;
+    }
+
+    IUnityXRDisplayInterface* m_Display = nullptr;
+    UnitySubsystemHandle m_Handle = nullptr;
+    std::vector<Entry> m_Entries;
+    uint32_t m_Frame = 0;
+    uint32_t m_Hits = 0;
+    uint32_t m_Misses = 0;
+};
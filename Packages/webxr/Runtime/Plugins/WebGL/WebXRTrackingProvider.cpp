@@ -1,11 +1,34 @@
 #include "UnityHeaders/IUnityXRInput.h"
 #include "UnityHeaders/IUnityXRTrace.h"
 
+#include "WebXRHapticQueue.h"
+#include "WebXRPoseFilter.h"
+#include "WebXRPoseHistory.h"
+#include "WebXRPoseMath.h"
+#include "WebXRPoseMotion.h"
 #include "WebXRProviderContext.h"
 
+#include <chrono>
 #include <cmath>
+#include <cstring>
 #include <stdio.h>
 
+extern "C"
+{
+  // webxr.jslib, the controllers and hands arrays shared with WebXRSubsystem.
+  extern float *WebXRGetControllersDataArray();
+  extern float *WebXRGetHandsDataArray();
+  // webxr.jslib, pulses the haptic actuator of controller 1 (left) or 2 (right). Intensity 0 stops it.
+  extern void ControllerPulse(int controller, float intensity, float duration);
+}
+
+static bool s_PosePredictionEnabled = false;
+static bool s_NativeControllersEnabled = false;
+static bool s_NativeHandsEnabled = false;
+static bool s_ControllerFilteringEnabled = false;
+static bool s_HandFilteringEnabled = false;
+static WebXRPoseFilterParameters s_PoseFilterParameters;
+
 class WebXRTrackingProvider : public ProviderImpl
 {
 public:
@@ -23,18 +46,253 @@ public:
   UnitySubsystemErrorCode UpdateDeviceState(UnityXRInternalInputDeviceId deviceId, UnityXRInputUpdateType updateType, UnityXRInputDeviceState *state);
   UnitySubsystemErrorCode HandleEvent(unsigned int eventType, UnityXRInternalInputDeviceId deviceId, void *buffer, unsigned int size);
   UnitySubsystemErrorCode TryGetDeviceStateAtTime(UnityXRTimeStamp time, UnityXRInternalInputDeviceId deviceId, UnityXRInputDeviceState *state);
+  UnitySubsystemErrorCode QueryHapticCapabilities(UnityXRInternalInputDeviceId deviceId, UnityXRHapticCapabilities *capabilities);
+  UnitySubsystemErrorCode HandleHapticImpulse(UnityXRInternalInputDeviceId deviceId, int channel, float amplitude, float duration);
+  UnitySubsystemErrorCode HandleHapticStop(UnityXRInternalInputDeviceId deviceId);
 
   void Stop() override;
   void Shutdown() override;
 
+  // Hands array block of the latched XR frame for hand 1 (left) or 2 (right), see XRHandData in webxr.jspre.
+  const float *GetHandData(int hand) const;
+  bool IsRunning() const { return m_Running; }
+  // Queues a pulse for the controller of hand 1 (left) or 2 (right), played on the next XR frame. duration in milliseconds.
+  void QueueHapticPulse(int hand, float amplitude, float duration);
+
 private:
+  struct Controller
+  {
+    UnityXRInternalInputDeviceId deviceId;
+    // XRControllerData.hand value, 1 for left and 2 for right.
+    int hand;
+    float *data = nullptr;
+    bool connected = false;
+    WebXRPoseHistory history;
+    WebXRPoseMotion motion;
+    WebXRPoseFilter pointerFilter;
+    WebXRPoseFilter gripFilter;
+    WebXRHapticQueue haptics;
+  };
+
+  // Floats per hand in the hands array: frame, enabled, hand, trigger, squeeze, pointer pose and 25 joints.
+  static const int kHandDataLength = 212;
+  static const int kHandJointsCount = 25;
+
+  struct Hand
+  {
+    UnityXRInternalInputDeviceId deviceId;
+    // XRHandData.hand value, 1 for left and 2 for right.
+    int hand;
+    float *data = nullptr;
+    bool connected = false;
+    float latchedData[kHandDataLength] = {};
+    WebXRPoseHistory history;
+    WebXRPoseMotion motion;
+    WebXRPoseFilter pointerFilter;
+    WebXRPoseFilter jointFilters[kHandJointsCount];
+  };
+
+  static double GetEpochTime();
+
   static const int kInputDeviceHMD = 72;
+  // Feature indices, in the order FillDeviceDefinition adds them.
+  enum HMDFeature
+  {
+    kHMDIsTracked,
+    kHMDTrackingState,
+    kHMDDevicePosition,
+    kHMDDeviceRotation,
+    kHMDDeviceVelocity,
+    kHMDDeviceAngularVelocity,
+    kHMDDeviceAcceleration,
+    kHMDDeviceAngularAcceleration,
+    kHMDCenterEyePosition,
+    kHMDCenterEyeRotation,
+    kHMDLeftEyePosition,
+    kHMDLeftEyeRotation,
+    kHMDRightEyePosition,
+    kHMDRightEyeRotation
+  };
+
+  static const int kInputDeviceLeftController = 73;
+  static const int kInputDeviceRightController = 74;
+  static const int kControllersCount = 2;
+  // Floats per controller in the controllers array, see XRControllerData in webxr.jspre.
+  // The right controller is first, the left one second.
+  static const int kControllerDataLength = 34;
+  enum ControllerData
+  {
+    kControllerDataFrame = 0,
+    kControllerDataEnabled = 1,
+    kControllerDataHand = 2,
+    kControllerDataPointerPosition = 3,
+    kControllerDataPointerRotation = 6,
+    kControllerDataTrigger = 10,
+    kControllerDataTriggerTouched = 11,
+    kControllerDataSqueeze = 12,
+    kControllerDataSqueezeTouched = 13,
+    kControllerDataThumbstick = 14,
+    kControllerDataThumbstickTouched = 15,
+    kControllerDataThumbstickX = 16,
+    kControllerDataThumbstickY = 17,
+    kControllerDataTouchpad = 18,
+    kControllerDataTouchpadTouched = 19,
+    kControllerDataTouchpadX = 20,
+    kControllerDataTouchpadY = 21,
+    kControllerDataButtonA = 22,
+    kControllerDataButtonATouched = 23,
+    kControllerDataButtonB = 24,
+    kControllerDataButtonBTouched = 25,
+    kControllerDataUpdatedGrip = 26,
+    kControllerDataGripPosition = 27,
+    kControllerDataGripRotation = 30
+  };
+  // Feature indices, in the order FillControllerDefinition adds them.
+  enum ControllerFeature
+  {
+    kControllerIsTracked,
+    kControllerTrackingState,
+    kControllerDevicePosition,
+    kControllerDeviceRotation,
+    kControllerDeviceVelocity,
+    kControllerDeviceAngularVelocity,
+    kControllerPointerPosition,
+    kControllerPointerRotation,
+    kControllerTrigger,
+    kControllerTriggerButton,
+    kControllerTriggerTouch,
+    kControllerGrip,
+    kControllerGripButton,
+    kControllerPrimary2DAxis,
+    kControllerPrimary2DAxisClick,
+    kControllerPrimary2DAxisTouch,
+    kControllerSecondary2DAxis,
+    kControllerSecondary2DAxisClick,
+    kControllerSecondary2DAxisTouch,
+    kControllerPrimaryButton,
+    kControllerPrimaryTouch,
+    kControllerSecondaryButton,
+    kControllerSecondaryTouch
+  };
+  // Trigger and grip values above it are pressed.
+  static constexpr float kButtonPressThreshold = 0.5f;
+
+  static const int kInputDeviceLeftHand = 75;
+  static const int kInputDeviceRightHand = 76;
+  static const int kHandsCount = 2;
+  // The left hand is first, the right one second.
+  enum HandData
+  {
+    kHandDataFrame = 0,
+    kHandDataEnabled = 1,
+    kHandDataHand = 2,
+    kHandDataTrigger = 3,
+    kHandDataSqueeze = 4,
+    kHandDataPointerPosition = 5,
+    kHandDataPointerRotation = 8,
+    // Position, rotation and radius of each joint, in WebXR joints order.
+    kHandDataJoints = 12,
+    kHandDataJointLength = 8
+  };
+  // Feature indices, in the order FillHandDefinition adds them.
+  enum HandFeature
+  {
+    kHandIsTracked,
+    kHandTrackingState,
+    kHandDevicePosition,
+    kHandDeviceRotation,
+    kHandDeviceVelocity,
+    kHandDeviceAngularVelocity,
+    kHandPointerPosition,
+    kHandPointerRotation,
+    kHandTrigger,
+    kHandTriggerButton,
+    kHandGrip,
+    kHandGripButton,
+    kHandHandData,
+    // One bone per WebXR joint, the wrist first.
+    kHandFirstBone
+  };
+
+  // One device as of the latest recorded XR frame. Copied, so later frames don't change it.
+  struct DeviceSnapshot
+  {
+    bool valid = false;
+    WebXRPoseSample sample = {};
+    WebXRPoseMotion motion;
+  };
+
+  struct HMDSnapshot : DeviceSnapshot
+  {
+    UnityXRVector3 leftEyeOffset = {};
+    UnityXRVector3 rightEyeOffset = {};
+  };
+
+  struct ControllerSnapshot : DeviceSnapshot
+  {
+    float data[kControllerDataLength] = {};
+  };
+
+  struct HandSnapshot : DeviceSnapshot
+  {
+    float data[kHandDataLength] = {};
+  };
+
+  // Devices states for one update type, taken by Tick and read by every UpdateDeviceState call until the next Tick.
+  struct InputSnapshot
+  {
+    bool taken = false;
+    HMDSnapshot hmd;
+    ControllerSnapshot controllers[kControllersCount];
+    HandSnapshot hands[kHandsCount];
+  };
+
+  void UpdateConnections();
+  void RecordFrame();
+  void FilterController(Controller &controller, double time);
+  void FilterHand(Hand &hand, double time);
+  static void FilterPose(WebXRPoseFilter &filter, float *poseData, double time);
+  void RecordController(Controller &controller, double time);
+  void FlushHaptics();
+  void RecordHand(Hand &hand, double time);
+  void TakeSnapshot(UnityXRInputUpdateType updateType);
+  void FillHandDefinition(const Hand &hand, UnityXRInputDeviceDefinition *definition);
+  // snapshot adds the motion, buttons and joints of the latest XR frame, historical states without it have only the device pose.
+  void SetHandState(const UnityXRPose &pose, const HandSnapshot *snapshot, UnityXRInputDeviceState *state);
+  Hand *GetHand(UnityXRInternalInputDeviceId deviceId);
+  void SetHMDState(const UnityXRPose &pose, const HMDSnapshot *snapshot, UnityXRInputDeviceState *state);
+  void FillControllerDefinition(const Controller &controller, UnityXRInputDeviceDefinition *definition);
+  void SetControllerState(const UnityXRPose &pose, const ControllerSnapshot *snapshot, UnityXRInputDeviceState *state);
+  Controller *GetController(UnityXRInternalInputDeviceId deviceId);
+
+  bool m_Running = false;
   float *m_ViewsDataArray;
   bool hasMultipleViews = true;
+  // Unix epoch time of the XR frame times origin, the first XR frame of the session, in milliseconds.
+  double m_TimeOrigin = 0.0;
+  float m_LastFrameTime = -1.0f;
+  int m_RecordedFrameNumber = -1;
+  WebXRPoseHistory m_HMDHistory;
+  WebXRPoseMotion m_HMDMotion;
+  // Eyes positions relative to the center pose, in head space.
+  UnityXRVector3 m_LeftEyeOffset = {};
+  UnityXRVector3 m_RightEyeOffset = {};
+  Controller m_Controllers[kControllersCount];
+  Hand m_Hands[kHandsCount];
+  // Indexed by UnityXRInputUpdateType.
+  InputSnapshot m_Snapshots[kUnityXRInputUpdateTypeBeforeRender + 1];
 };
 
 UnitySubsystemErrorCode WebXRTrackingProvider::Initialize()
 {
+  m_Controllers[0].deviceId = kInputDeviceLeftController;
+  m_Controllers[0].hand = 1;
+  m_Controllers[1].deviceId = kInputDeviceRightController;
+  m_Controllers[1].hand = 2;
+  m_Hands[0].deviceId = kInputDeviceLeftHand;
+  m_Hands[0].hand = 1;
+  m_Hands[1].deviceId = kInputDeviceRightHand;
+  m_Hands[1].hand = 2;
   return kUnitySubsystemErrorCodeSuccess;
 }
 
@@ -42,28 +300,141 @@ UnitySubsystemErrorCode WebXRTrackingProvider::Start()
 {
   m_ViewsDataArray = WebXRGetViewsDataArray();
   hasMultipleViews = *(m_ViewsDataArray + 54) > 1;
+  m_LastFrameTime = -1.0f;
+  m_RecordedFrameNumber = -1;
+  for (InputSnapshot &snapshot : m_Snapshots)
+  {
+    snapshot.taken = false;
+  }
+  m_HMDHistory.Clear();
+  m_HMDMotion.Reset();
   m_Ctx.input->InputSubsystem_DeviceConnected(m_Handle, kInputDeviceHMD);
+  m_Running = true;
+
+  float *controllersData = WebXRGetControllersDataArray();
+  m_Controllers[0].data = controllersData + kControllerDataLength;
+  m_Controllers[1].data = controllersData;
+  for (int i = 0; i < kControllersCount; ++i)
+  {
+    m_Controllers[i].connected = false;
+    m_Controllers[i].history.Clear();
+    m_Controllers[i].motion.Reset();
+    m_Controllers[i].pointerFilter.Reset();
+    m_Controllers[i].gripFilter.Reset();
+    m_Controllers[i].haptics.Clear();
+  }
+
+  float *handsData = WebXRGetHandsDataArray();
+  for (int i = 0; i < kHandsCount; ++i)
+  {
+    m_Hands[i].data = handsData + i * kHandDataLength;
+    m_Hands[i].connected = false;
+    m_Hands[i].latchedData[kHandDataEnabled] = 0.0f;
+    m_Hands[i].history.Clear();
+    m_Hands[i].motion.Reset();
+    m_Hands[i].pointerFilter.Reset();
+    for (WebXRPoseFilter &filter : m_Hands[i].jointFilters)
+    {
+      filter.Reset();
+    }
+  }
   return kUnitySubsystemErrorCodeSuccess;
 }
 
 UnitySubsystemErrorCode WebXRTrackingProvider::Tick(UnityXRInputUpdateType updateType)
 {
+  // Both update types latch the newest XR frame, unless the display already did for this frame,
+  // so BeforeRender poses are at least as fresh as the ones Update used.
+  m_Ctx.frameSnapshot.Latch(m_ViewsDataArray);
+  UpdateConnections();
+  RecordFrame();
+  TakeSnapshot(updateType);
   return kUnitySubsystemErrorCodeSuccess;
 }
 
+void WebXRTrackingProvider::UpdateConnections()
+{
+  // Hands come and go with the XR session input sources.
+  for (int i = 0; i < kHandsCount && s_NativeHandsEnabled; ++i)
+  {
+    Hand &hand = m_Hands[i];
+    bool enabled = hand.data[kHandDataEnabled] != 0.0f && (int)hand.data[kHandDataHand] == hand.hand;
+    if (enabled == hand.connected)
+    {
+      continue;
+    }
+    hand.connected = enabled;
+    if (enabled)
+    {
+      m_Ctx.input->InputSubsystem_DeviceConnected(m_Handle, hand.deviceId);
+    }
+    else
+    {
+      m_Ctx.input->InputSubsystem_DeviceDisconnected(m_Handle, hand.deviceId);
+      hand.latchedData[kHandDataEnabled] = 0.0f;
+      hand.history.Clear();
+      hand.motion.Reset();
+    }
+  }
+
+  if (!s_NativeControllersEnabled)
+  {
+    return;
+  }
+  // Controllers come and go with the XR session input sources.
+  for (int i = 0; i < kControllersCount; ++i)
+  {
+    Controller &controller = m_Controllers[i];
+    bool enabled = controller.data[kControllerDataEnabled] != 0.0f
+        && (int)controller.data[kControllerDataHand] == controller.hand;
+    if (enabled == controller.connected)
+    {
+      continue;
+    }
+    controller.connected = enabled;
+    if (enabled)
+    {
+      m_Ctx.input->InputSubsystem_DeviceConnected(m_Handle, controller.deviceId);
+    }
+    else
+    {
+      m_Ctx.input->InputSubsystem_DeviceDisconnected(m_Handle, controller.deviceId);
+      controller.history.Clear();
+      controller.motion.Reset();
+    }
+  }
+}
+
 UnitySubsystemErrorCode WebXRTrackingProvider::FillDeviceDefinition(UnityXRInternalInputDeviceId deviceId, UnityXRInputDeviceDefinition *definition)
 {
   // Fill in your connected device information here when requested.  Used to create customized device states.
+  const Controller *controller = GetController(deviceId);
+  if (controller)
+  {
+    FillControllerDefinition(*controller, definition);
+    return kUnitySubsystemErrorCodeSuccess;
+  }
+  const Hand *hand = GetHand(deviceId);
+  if (hand)
+  {
+    FillHandDefinition(*hand, definition);
+    return kUnitySubsystemErrorCodeSuccess;
+  }
   auto &input = *m_Ctx.input;
   input.DeviceDefinition_SetName(definition, "WebXR Tracked Display");
   input.DeviceDefinition_SetCharacteristics(definition, (UnityXRInputDeviceCharacteristics)(kUnityXRInputDeviceCharacteristicsHeadMounted | kUnityXRInputDeviceCharacteristicsTrackedDevice));
   input.DeviceDefinition_SetManufacturer(definition, "WebXR");
+  input.DeviceDefinition_SetCanQueryForDeviceStateAtTime(definition, true);
 
   input.DeviceDefinition_AddFeatureWithUsage(definition, "is tracked", kUnityXRInputFeatureTypeBinary, kUnityXRInputFeatureUsageIsTracked);
   input.DeviceDefinition_AddFeatureWithUsage(definition, "tracking state", kUnityXRInputFeatureTypeDiscreteStates, kUnityXRInputFeatureUsageTrackingState);
 
   input.DeviceDefinition_AddFeatureWithUsage(definition, "device position", kUnityXRInputFeatureTypeAxis3D, kUnityXRInputFeatureUsageDevicePosition);
   input.DeviceDefinition_AddFeatureWithUsage(definition, "device rotation", kUnityXRInputFeatureTypeRotation, kUnityXRInputFeatureUsageDeviceRotation);
+  input.DeviceDefinition_AddFeatureWithUsage(definition, "device velocity", kUnityXRInputFeatureTypeAxis3D, kUnityXRInputFeatureUsageDeviceVelocity);
+  input.DeviceDefinition_AddFeatureWithUsage(definition, "device angular velocity", kUnityXRInputFeatureTypeAxis3D, kUnityXRInputFeatureUsageDeviceAngularVelocity);
+  input.DeviceDefinition_AddFeatureWithUsage(definition, "device acceleration", kUnityXRInputFeatureTypeAxis3D, kUnityXRInputFeatureUsageDeviceAcceleration);
+  input.DeviceDefinition_AddFeatureWithUsage(definition, "device angular acceleration", kUnityXRInputFeatureTypeAxis3D, kUnityXRInputFeatureUsageDeviceAngularAcceleration);
   input.DeviceDefinition_AddFeatureWithUsage(definition, "center eye position", kUnityXRInputFeatureTypeAxis3D, kUnityXRInputFeatureUsageCenterEyePosition);
   input.DeviceDefinition_AddFeatureWithUsage(definition, "center eye rotation", kUnityXRInputFeatureTypeRotation, kUnityXRInputFeatureUsageCenterEyeRotation);
   if (hasMultipleViews)
@@ -77,58 +448,562 @@ UnitySubsystemErrorCode WebXRTrackingProvider::FillDeviceDefinition(UnityXRInter
   return kUnitySubsystemErrorCodeSuccess;
 }
 
+void WebXRTrackingProvider::FillControllerDefinition(const Controller &controller, UnityXRInputDeviceDefinition *definition)
+{
+  auto &input = *m_Ctx.input;
+  bool left = controller.deviceId == kInputDeviceLeftController;
+  input.DeviceDefinition_SetName(definition, left ? "WebXR Controller Left" : "WebXR Controller Right");
+  input.DeviceDefinition_SetCharacteristics(definition, (UnityXRInputDeviceCharacteristics)(kUnityXRInputDeviceCharacteristicsHeldInHand
+      | kUnityXRInputDeviceCharacteristicsTrackedDevice | kUnityXRInputDeviceCharacteristicsController
+      | (left ? kUnityXRInputDeviceCharacteristicsLeft : kUnityXRInputDeviceCharacteristicsRight)));
+  input.DeviceDefinition_SetManufacturer(definition, "WebXR");
+  input.DeviceDefinition_SetCanQueryForDeviceStateAtTime(definition, true);
+
+  input.DeviceDefinition_AddFeatureWithUsage(definition, "is tracked", kUnityXRInputFeatureTypeBinary, kUnityXRInputFeatureUsageIsTracked);
+  input.DeviceDefinition_AddFeatureWithUsage(definition, "tracking state", kUnityXRInputFeatureTypeDiscreteStates, kUnityXRInputFeatureUsageTrackingState);
+
+  // Grip space, or the target ray space when the input source has no grip space.
+  input.DeviceDefinition_AddFeatureWithUsage(definition, "device position", kUnityXRInputFeatureTypeAxis3D, kUnityXRInputFeatureUsageDevicePosition);
+  input.DeviceDefinition_AddFeatureWithUsage(definition, "device rotation", kUnityXRInputFeatureTypeRotation, kUnityXRInputFeatureUsageDeviceRotation);
+  input.DeviceDefinition_AddFeatureWithUsage(definition, "device velocity", kUnityXRInputFeatureTypeAxis3D, kUnityXRInputFeatureUsageDeviceVelocity);
+  input.DeviceDefinition_AddFeatureWithUsage(definition, "device angular velocity", kUnityXRInputFeatureTypeAxis3D, kUnityXRInputFeatureUsageDeviceAngularVelocity);
+  // Target ray space, there's no standard usage for it.
+  input.DeviceDefinition_AddFeature(definition, "pointer position", kUnityXRInputFeatureTypeAxis3D);
+  input.DeviceDefinition_AddFeature(definition, "pointer rotation", kUnityXRInputFeatureTypeRotation);
+
+  // xr-standard gamepad mapping
+  input.DeviceDefinition_AddFeatureWithUsage(definition, "trigger", kUnityXRInputFeatureTypeAxis1D, kUnityXRInputFeatureUsageTrigger);
+  input.DeviceDefinition_AddFeatureWithUsage(definition, "trigger button", kUnityXRInputFeatureTypeBinary, kUnityXRInputFeatureUsageTriggerButton);
+  input.DeviceDefinition_AddFeature(definition, "trigger touch", kUnityXRInputFeatureTypeBinary);
+  input.DeviceDefinition_AddFeatureWithUsage(definition, "grip", kUnityXRInputFeatureTypeAxis1D, kUnityXRInputFeatureUsageGrip);
+  input.DeviceDefinition_AddFeatureWithUsage(definition, "grip button", kUnityXRInputFeatureTypeBinary, kUnityXRInputFeatureUsageGripButton);
+  input.DeviceDefinition_AddFeatureWithUsage(definition, "thumbstick", kUnityXRInputFeatureTypeAxis2D, kUnityXRInputFeatureUsagePrimary2DAxis);
+  input.DeviceDefinition_AddFeatureWithUsage(definition, "thumbstick clicked", kUnityXRInputFeatureTypeBinary, kUnityXRInputFeatureUsagePrimary2DAxisClick);
+  input.DeviceDefinition_AddFeatureWithUsage(definition, "thumbstick touched", kUnityXRInputFeatureTypeBinary, kUnityXRInputFeatureUsagePrimary2DAxisTouch);
+  input.DeviceDefinition_AddFeatureWithUsage(definition, "touchpad", kUnityXRInputFeatureTypeAxis2D, kUnityXRInputFeatureUsageSecondary2DAxis);
+  input.DeviceDefinition_AddFeatureWithUsage(definition, "touchpad clicked", kUnityXRInputFeatureTypeBinary, kUnityXRInputFeatureUsageSecondary2DAxisClick);
+  input.DeviceDefinition_AddFeatureWithUsage(definition, "touchpad touched", kUnityXRInputFeatureTypeBinary, kUnityXRInputFeatureUsageSecondary2DAxisTouch);
+  input.DeviceDefinition_AddFeatureWithUsage(definition, "primary button", kUnityXRInputFeatureTypeBinary, kUnityXRInputFeatureUsagePrimaryButton);
+  input.DeviceDefinition_AddFeatureWithUsage(definition, "primary touch", kUnityXRInputFeatureTypeBinary, kUnityXRInputFeatureUsagePrimaryTouch);
+  input.DeviceDefinition_AddFeatureWithUsage(definition, "secondary button", kUnityXRInputFeatureTypeBinary, kUnityXRInputFeatureUsageSecondaryButton);
+  input.DeviceDefinition_AddFeatureWithUsage(definition, "secondary touch", kUnityXRInputFeatureTypeBinary, kUnityXRInputFeatureUsageSecondaryTouch);
+}
+
+void WebXRTrackingProvider::FillHandDefinition(const Hand &hand, UnityXRInputDeviceDefinition *definition)
+{
+  static const char *kJointNames[kHandJointsCount] = {
+      "wrist",
+      "thumb metacarpal", "thumb phalanx proximal", "thumb phalanx distal", "thumb tip",
+      "index finger metacarpal", "index finger phalanx proximal", "index finger phalanx intermediate", "index finger phalanx distal", "index finger tip",
+      "middle finger metacarpal", "middle finger phalanx proximal", "middle finger phalanx intermediate", "middle finger phalanx distal", "middle finger tip",
+      "ring finger metacarpal", "ring finger phalanx proximal", "ring finger phalanx intermediate", "ring finger phalanx distal", "ring finger tip",
+      "pinky finger metacarpal", "pinky finger phalanx proximal", "pinky finger phalanx intermediate", "pinky finger phalanx distal", "pinky finger tip"};
+
+  auto &input = *m_Ctx.input;
+  bool left = hand.deviceId == kInputDeviceLeftHand;
+  input.DeviceDefinition_SetName(definition, left ? "WebXR Hand Left" : "WebXR Hand Right");
+  input.DeviceDefinition_SetCharacteristics(definition, (UnityXRInputDeviceCharacteristics)(kUnityXRInputDeviceCharacteristicsHandTracking
+      | kUnityXRInputDeviceCharacteristicsTrackedDevice
+      | (left ? kUnityXRInputDeviceCharacteristicsLeft : kUnityXRInputDeviceCharacteristicsRight)));
+  input.DeviceDefinition_SetManufacturer(definition, "WebXR");
+  input.DeviceDefinition_SetCanQueryForDeviceStateAtTime(definition, true);
+
+  input.DeviceDefinition_AddFeatureWithUsage(definition, "is tracked", kUnityXRInputFeatureTypeBinary, kUnityXRInputFeatureUsageIsTracked);
+  input.DeviceDefinition_AddFeatureWithUsage(definition, "tracking state", kUnityXRInputFeatureTypeDiscreteStates, kUnityXRInputFeatureUsageTrackingState);
+
+  // Wrist joint
+  input.DeviceDefinition_AddFeatureWithUsage(definition, "device position", kUnityXRInputFeatureTypeAxis3D, kUnityXRInputFeatureUsageDevicePosition);
+  input.DeviceDefinition_AddFeatureWithUsage(definition, "device rotation", kUnityXRInputFeatureTypeRotation, kUnityXRInputFeatureUsageDeviceRotation);
+  input.DeviceDefinition_AddFeatureWithUsage(definition, "device velocity", kUnityXRInputFeatureTypeAxis3D, kUnityXRInputFeatureUsageDeviceVelocity);
+  input.DeviceDefinition_AddFeatureWithUsage(definition, "device angular velocity", kUnityXRInputFeatureTypeAxis3D, kUnityXRInputFeatureUsageDeviceAngularVelocity);
+  input.DeviceDefinition_AddFeature(definition, "pointer position", kUnityXRInputFeatureTypeAxis3D);
+  input.DeviceDefinition_AddFeature(definition, "pointer rotation", kUnityXRInputFeatureTypeRotation);
+
+  // Pinch and squeeze, as webxr.jspre computes them.
+  input.DeviceDefinition_AddFeatureWithUsage(definition, "trigger", kUnityXRInputFeatureTypeAxis1D, kUnityXRInputFeatureUsageTrigger);
+  input.DeviceDefinition_AddFeatureWithUsage(definition, "trigger button", kUnityXRInputFeatureTypeBinary, kUnityXRInputFeatureUsageTriggerButton);
+  input.DeviceDefinition_AddFeatureWithUsage(definition, "grip", kUnityXRInputFeatureTypeAxis1D, kUnityXRInputFeatureUsageGrip);
+  input.DeviceDefinition_AddFeatureWithUsage(definition, "grip button", kUnityXRInputFeatureTypeBinary, kUnityXRInputFeatureUsageGripButton);
+
+  input.DeviceDefinition_AddFeatureWithUsage(definition, "hand data", kUnityXRInputFeatureTypeHand, kUnityXRInputFeatureUsageHandData);
+  for (int i = 0; i < kHandJointsCount; ++i)
+  {
+    input.DeviceDefinition_AddFeature(definition, kJointNames[i], kUnityXRInputFeatureTypeBone);
+  }
+}
+
 UnitySubsystemErrorCode WebXRTrackingProvider::UpdateDeviceState(UnityXRInternalInputDeviceId deviceId, UnityXRInputUpdateType updateType, UnityXRInputDeviceState *state)
 {
-  if (deviceId != kInputDeviceHMD)
+  /// Called by Unity when it needs a current device snapshot
+  // Served from the snapshot of the last Tick of this update type, so all devices see the same XR frame.
+  if (!m_Snapshots[updateType].taken)
   {
+    Tick(updateType);
+  }
+  const InputSnapshot &snapshot = m_Snapshots[updateType];
+
+  const Controller *controller = GetController(deviceId);
+  if (controller)
+  {
+    const ControllerSnapshot &controllerSnapshot = snapshot.controllers[controller - m_Controllers];
+    if (controllerSnapshot.valid)
+    {
+      SetControllerState(controllerSnapshot.sample.pose, &controllerSnapshot, state);
+      m_Ctx.input->DeviceState_SetDeviceTime(state, (UnityXRTimeStamp)controllerSnapshot.sample.time);
+    }
     return kUnitySubsystemErrorCodeSuccess;
   }
-  /// Called by Unity when it needs a current device snapshot
-  UnityXRVector3 position;
-  UnityXRVector4 rotation;
-  auto &input = *m_Ctx.input;
+  const Hand *hand = GetHand(deviceId);
+  if (hand)
+  {
+    const HandSnapshot &handSnapshot = snapshot.hands[hand - m_Hands];
+    if (handSnapshot.valid)
+    {
+      SetHandState(handSnapshot.sample.pose, &handSnapshot, state);
+      m_Ctx.input->DeviceState_SetDeviceTime(state, (UnityXRTimeStamp)handSnapshot.sample.time);
+    }
+    return kUnitySubsystemErrorCodeSuccess;
+  }
+  if (deviceId != kInputDeviceHMD || !snapshot.hmd.valid)
+  {
+    return kUnitySubsystemErrorCodeSuccess;
+  }
+  SetHMDState(snapshot.hmd.sample.pose, &snapshot.hmd, state);
+  m_Ctx.input->DeviceState_SetDeviceTime(state, (UnityXRTimeStamp)snapshot.hmd.sample.time);
+
+  return kUnitySubsystemErrorCodeSuccess;
+}
+
+void WebXRTrackingProvider::TakeSnapshot(UnityXRInputUpdateType updateType)
+{
+  InputSnapshot &snapshot = m_Snapshots[updateType];
+  snapshot.taken = true;
+
+  HMDSnapshot &hmd = snapshot.hmd;
+  hmd.valid = m_HMDHistory.GetLatest(hmd.sample);
+  hmd.motion = m_HMDMotion;
+  hmd.leftEyeOffset = m_LeftEyeOffset;
+  hmd.rightEyeOffset = m_RightEyeOffset;
+  if (hmd.valid && s_PosePredictionEnabled && updateType == kUnityXRInputUpdateTypeBeforeRender)
+  {
+    // Extrapolate from the XR frame time to the time the frame will be displayed.
+    const float *viewsData = m_Ctx.frameSnapshot.viewsData;
+    float predictedDisplayTime = *(viewsData + 61);
+    float seconds = predictedDisplayTime > 0.0f ? 0.001f * (predictedDisplayTime - *(viewsData + 60)) : 0.0f;
+    hmd.sample.pose = m_HMDMotion.Predict(hmd.sample.pose, seconds);
+  }
+
+  for (int i = 0; i < kControllersCount; ++i)
+  {
+    const Controller &controller = m_Controllers[i];
+    ControllerSnapshot &controllerSnapshot = snapshot.controllers[i];
+    controllerSnapshot.valid = controller.connected && controller.history.GetLatest(controllerSnapshot.sample);
+    if (controllerSnapshot.valid)
+    {
+      controllerSnapshot.motion = controller.motion;
+      memcpy(controllerSnapshot.data, controller.data, sizeof(controllerSnapshot.data));
+    }
+  }
+  for (int i = 0; i < kHandsCount; ++i)
+  {
+    const Hand &hand = m_Hands[i];
+    HandSnapshot &handSnapshot = snapshot.hands[i];
+    handSnapshot.valid = hand.connected && hand.history.GetLatest(handSnapshot.sample);
+    if (handSnapshot.valid)
+    {
+      handSnapshot.motion = hand.motion;
+      memcpy(handSnapshot.data, hand.latchedData, sizeof(handSnapshot.data));
+    }
+  }
+}
+
+// Adds the poses of the latched XR frame to the history, once per XR frame.
+void WebXRTrackingProvider::RecordFrame()
+{
+  const WebXRFrameSnapshot &snapshot = m_Ctx.frameSnapshot;
+  if (snapshot.frameNumber == m_RecordedFrameNumber)
+  {
+    return;
+  }
+  m_RecordedFrameNumber = snapshot.frameNumber;
+  const float *viewsData = snapshot.viewsData;
+
+  UnityXRPose pose;
   int start = 32;
-  rotation.x = *(m_ViewsDataArray + start);
-  rotation.y = *(m_ViewsDataArray + start + 1);
-  rotation.z = *(m_ViewsDataArray + start + 2);
-  rotation.w = *(m_ViewsDataArray + start + 3);
+  pose.rotation.x = *(viewsData + start);
+  pose.rotation.y = *(viewsData + start + 1);
+  pose.rotation.z = *(viewsData + start + 2);
+  pose.rotation.w = *(viewsData + start + 3);
   start = 40;
   // Get left position first
-  position.x = *(m_ViewsDataArray + start);
-  position.y = *(m_ViewsDataArray + start + 1);
-  position.z = *(m_ViewsDataArray + start + 2);
+  pose.position.x = *(viewsData + start);
+  pose.position.y = *(viewsData + start + 1);
+  pose.position.z = *(viewsData + start + 2);
+
+  if (hasMultipleViews)
+  {
+    UnityXRVector3 rightPosition;
+    rightPosition.x = *(viewsData + start + 3);
+    rightPosition.y = *(viewsData + start + 4);
+    rightPosition.z = *(viewsData + start + 5);
+    UnityXRVector3 leftPosition = pose.position;
+
+    // Center pose
+    pose.position = WebXRPoseMath::Lerp(leftPosition, rightPosition, 0.5f);
+
+    UnityXRVector4 inverseRotation = WebXRPoseMath::Conjugate(pose.rotation);
+    m_LeftEyeOffset = WebXRPoseMath::Rotate(inverseRotation, {leftPosition.x - pose.position.x,
+                                                              leftPosition.y - pose.position.y,
+                                                              leftPosition.z - pose.position.z});
+    m_RightEyeOffset = WebXRPoseMath::Rotate(inverseRotation, {rightPosition.x - pose.position.x,
+                                                               rightPosition.y - pose.position.y,
+                                                               rightPosition.z - pose.position.z});
+  }
+
+  // Frame times are relative to the first XR frame of the session. The epoch time of that origin is the
+  // smallest difference seen between now and the latched frame time, as latching only adds delay.
+  float frameTime = *(viewsData + 60);
+  double timeOrigin = GetEpochTime() - frameTime;
+  if (frameTime < m_LastFrameTime || m_LastFrameTime < 0.0f || timeOrigin < m_TimeOrigin)
+  {
+    m_TimeOrigin = timeOrigin;
+  }
+  m_LastFrameTime = frameTime;
+
+  double time = m_TimeOrigin + frameTime;
+  m_HMDHistory.Add(time, pose);
+  m_HMDMotion.Add(time, pose);
+
+  // Filtered in place, so WebXRSubsystem reads the same poses as the native devices.
+  for (int i = 0; i < kControllersCount && s_ControllerFilteringEnabled; ++i)
+  {
+    FilterController(m_Controllers[i], time);
+  }
+  for (int i = 0; i < kHandsCount && s_HandFilteringEnabled; ++i)
+  {
+    FilterHand(m_Hands[i], time);
+  }
+  for (int i = 0; i < kControllersCount; ++i)
+  {
+    if (m_Controllers[i].connected)
+    {
+      RecordController(m_Controllers[i], time);
+    }
+  }
+  for (int i = 0; i < kHandsCount; ++i)
+  {
+    if (m_Hands[i].connected)
+    {
+      RecordHand(m_Hands[i], time);
+    }
+  }
+  FlushHaptics();
+}
+
+// Sends the haptic commands queued since the last XR frame, at most one pulse per controller.
+void WebXRTrackingProvider::FlushHaptics()
+{
+  double now = GetEpochTime();
+  for (int i = 0; i < kControllersCount; ++i)
+  {
+    Controller &controller = m_Controllers[i];
+    WebXRHapticPulse pulse;
+    if (controller.haptics.Flush(now, pulse))
+    {
+      ControllerPulse(controller.hand, pulse.amplitude, pulse.duration);
+    }
+  }
+}
+
+void WebXRTrackingProvider::QueueHapticPulse(int hand, float amplitude, float duration)
+{
+  for (int i = 0; i < kControllersCount; ++i)
+  {
+    // Controllers without handedness are in the right controller slot.
+    if (m_Controllers[i].hand == (hand == 1 ? 1 : 2))
+    {
+      m_Controllers[i].haptics.Pulse(amplitude, duration);
+    }
+  }
+}
+
+void WebXRTrackingProvider::FilterController(Controller &controller, double time)
+{
+  float *data = controller.data;
+  if (data[kControllerDataEnabled] == 0.0f)
+  {
+    controller.pointerFilter.Reset();
+    controller.gripFilter.Reset();
+    return;
+  }
+  FilterPose(controller.pointerFilter, data + kControllerDataPointerPosition, time);
+  if (data[kControllerDataUpdatedGrip] != 0.0f)
+  {
+    FilterPose(controller.gripFilter, data + kControllerDataGripPosition, time);
+  }
+}
+
+void WebXRTrackingProvider::FilterHand(Hand &hand, double time)
+{
+  float *data = hand.data;
+  if (data[kHandDataEnabled] == 0.0f)
+  {
+    hand.pointerFilter.Reset();
+    for (WebXRPoseFilter &filter : hand.jointFilters)
+    {
+      filter.Reset();
+    }
+    return;
+  }
+  FilterPose(hand.pointerFilter, data + kHandDataPointerPosition, time);
+  for (int i = 0; i < kHandJointsCount; ++i)
+  {
+    FilterPose(hand.jointFilters[i], data + kHandDataJoints + i * kHandDataJointLength, time);
+  }
+}
+
+// poseData is a position followed by a rotation, like all poses of the shared arrays.
+// The filtered pose is written back in place. When the browser skips an update of the pose,
+// the array still holds the last filtered pose, it isn't a new sample and is left as is.
+void WebXRTrackingProvider::FilterPose(WebXRPoseFilter &filter, float *poseData, double time)
+{
+  UnityXRPose pose;
+  pose.position = {poseData[0], poseData[1], poseData[2]};
+  pose.rotation = {poseData[3], poseData[4], poseData[5], poseData[6]};
+  if (filter.HasPose() && memcmp(&pose, &filter.GetPose(), sizeof(UnityXRPose)) == 0)
+  {
+    return;
+  }
+  const UnityXRPose &filtered = filter.Filter(time, pose, s_PoseFilterParameters);
+  poseData[0] = filtered.position.x;
+  poseData[1] = filtered.position.y;
+  poseData[2] = filtered.position.z;
+  poseData[3] = filtered.rotation.x;
+  poseData[4] = filtered.rotation.y;
+  poseData[5] = filtered.rotation.z;
+  poseData[6] = filtered.rotation.w;
+}
+
+// Latches the hand block once per XR frame, so the device state and the hands provider read the same joints.
+void WebXRTrackingProvider::RecordHand(Hand &hand, double time)
+{
+  memcpy(hand.latchedData, hand.data, sizeof(hand.latchedData));
+  if (hand.latchedData[kHandDataEnabled] == 0.0f)
+  {
+    return;
+  }
+  const float *wrist = hand.latchedData + kHandDataJoints;
+  UnityXRPose pose;
+  pose.position = {wrist[0], wrist[1], wrist[2]};
+  pose.rotation = {wrist[3], wrist[4], wrist[5], wrist[6]};
+  hand.history.Add(time, pose);
+  hand.motion.Add(time, pose);
+}
+
+WebXRTrackingProvider::Hand *WebXRTrackingProvider::GetHand(UnityXRInternalInputDeviceId deviceId)
+{
+  for (int i = 0; i < kHandsCount; ++i)
+  {
+    if (m_Hands[i].deviceId == deviceId)
+    {
+      return &m_Hands[i];
+    }
+  }
+  return nullptr;
+}
+
+const float *WebXRTrackingProvider::GetHandData(int hand) const
+{
+  for (int i = 0; i < kHandsCount; ++i)
+  {
+    if (m_Hands[i].hand == hand && m_Hands[i].connected)
+    {
+      return m_Hands[i].latchedData;
+    }
+  }
+  return nullptr;
+}
+
+void WebXRTrackingProvider::RecordController(Controller &controller, double time)
+{
+  const float *data = controller.data;
+  if (data[kControllerDataEnabled] == 0.0f)
+  {
+    return;
+  }
+  int start = data[kControllerDataUpdatedGrip] != 0.0f ? kControllerDataGripPosition : kControllerDataPointerPosition;
+  UnityXRPose pose;
+  pose.position = {data[start], data[start + 1], data[start + 2]};
+  pose.rotation = {data[start + 3], data[start + 4], data[start + 5], data[start + 6]};
+  controller.history.Add(time, pose);
+  controller.motion.Add(time, pose);
+}
+
+WebXRTrackingProvider::Controller *WebXRTrackingProvider::GetController(UnityXRInternalInputDeviceId deviceId)
+{
+  for (int i = 0; i < kControllersCount; ++i)
+  {
+    if (m_Controllers[i].deviceId == deviceId)
+    {
+      return &m_Controllers[i];
+    }
+  }
+  return nullptr;
+}
+
+double WebXRTrackingProvider::GetEpochTime()
+{
+  return std::chrono::duration<double, std::milli>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
 
+void WebXRTrackingProvider::SetHMDState(const UnityXRPose &pose, const HMDSnapshot *snapshot, UnityXRInputDeviceState *state)
+{
+  auto &input = *m_Ctx.input;
   if (hasMultipleViews)
   {
+    UnityXRVector3 offset = WebXRPoseMath::Rotate(pose.rotation, snapshot ? snapshot->leftEyeOffset : m_LeftEyeOffset);
     // Left pose
-    input.DeviceState_SetAxis3DValue(state, 6, position);
-    input.DeviceState_SetRotationValue(state, 7, rotation);
+    input.DeviceState_SetAxis3DValue(state, kHMDLeftEyePosition, {pose.position.x + offset.x, pose.position.y + offset.y, pose.position.z + offset.z});
+    input.DeviceState_SetRotationValue(state, kHMDLeftEyeRotation, pose.rotation);
 
-    UnityXRVector3 rightPosition;
-    rightPosition.x = *(m_ViewsDataArray + start + 3);
-    rightPosition.y = *(m_ViewsDataArray + start + 4);
-    rightPosition.z = *(m_ViewsDataArray + start + 5);
+    offset = WebXRPoseMath::Rotate(pose.rotation, snapshot ? snapshot->rightEyeOffset : m_RightEyeOffset);
     // Right pose
-    input.DeviceState_SetAxis3DValue(state, 8, position);
-    input.DeviceState_SetRotationValue(state, 9, rotation);
-
-    // Update center pose
-    position.x = 0.5f * (position.x + rightPosition.x);
-    position.y = 0.5f * (position.y + rightPosition.y);
-    position.z = 0.5f * (position.z + rightPosition.z);
+    input.DeviceState_SetAxis3DValue(state, kHMDRightEyePosition, {pose.position.x + offset.x, pose.position.y + offset.y, pose.position.z + offset.z});
+    input.DeviceState_SetRotationValue(state, kHMDRightEyeRotation, pose.rotation);
   }
   // Center pose
-  input.DeviceState_SetAxis3DValue(state, 2, position);
-  input.DeviceState_SetRotationValue(state, 3, rotation);
+  input.DeviceState_SetAxis3DValue(state, kHMDCenterEyePosition, pose.position);
+  input.DeviceState_SetRotationValue(state, kHMDCenterEyeRotation, pose.rotation);
   // Device pose
-  input.DeviceState_SetAxis3DValue(state, 4, position);
-  input.DeviceState_SetRotationValue(state, 5, rotation);
+  input.DeviceState_SetAxis3DValue(state, kHMDDevicePosition, pose.position);
+  input.DeviceState_SetRotationValue(state, kHMDDeviceRotation, pose.rotation);
+
+  unsigned int trackingState = kUnityXRInputTrackingStatePosition | kUnityXRInputTrackingStateRotation;
+  if (snapshot && snapshot->motion.HasVelocity())
+  {
+    input.DeviceState_SetAxis3DValue(state, kHMDDeviceVelocity, snapshot->motion.GetVelocity());
+    input.DeviceState_SetAxis3DValue(state, kHMDDeviceAngularVelocity, snapshot->motion.GetAngularVelocity());
+    trackingState |= kUnityXRInputTrackingStateVelocity | kUnityXRInputTrackingStateAngularVelocity;
+  }
+  if (snapshot && snapshot->motion.HasAcceleration())
+  {
+    input.DeviceState_SetAxis3DValue(state, kHMDDeviceAcceleration, snapshot->motion.GetAcceleration());
+    input.DeviceState_SetAxis3DValue(state, kHMDDeviceAngularAcceleration, snapshot->motion.GetAngularAcceleration());
+    trackingState |= kUnityXRInputTrackingStateAcceleration | kUnityXRInputTrackingStateAngularAcceleration;
+  }
 
   // Tracking
-  input.DeviceState_SetBinaryValue(state, 0, true);
-  input.DeviceState_SetDiscreteStateValue(state, 1, 3);
+  input.DeviceState_SetBinaryValue(state, kHMDIsTracked, true);
+  input.DeviceState_SetDiscreteStateValue(state, kHMDTrackingState, trackingState);
+}
 
-  return kUnitySubsystemErrorCodeSuccess;
+void WebXRTrackingProvider::SetControllerState(const UnityXRPose &pose, const ControllerSnapshot *snapshot, UnityXRInputDeviceState *state)
+{
+  auto &input = *m_Ctx.input;
+  input.DeviceState_SetAxis3DValue(state, kControllerDevicePosition, pose.position);
+  input.DeviceState_SetRotationValue(state, kControllerDeviceRotation, pose.rotation);
+
+  unsigned int trackingState = kUnityXRInputTrackingStatePosition | kUnityXRInputTrackingStateRotation;
+  if (snapshot && snapshot->motion.HasVelocity())
+  {
+    input.DeviceState_SetAxis3DValue(state, kControllerDeviceVelocity, snapshot->motion.GetVelocity());
+    input.DeviceState_SetAxis3DValue(state, kControllerDeviceAngularVelocity, snapshot->motion.GetAngularVelocity());
+    trackingState |= kUnityXRInputTrackingStateVelocity | kUnityXRInputTrackingStateAngularVelocity;
+  }
+  input.DeviceState_SetBinaryValue(state, kControllerIsTracked, true);
+  input.DeviceState_SetDiscreteStateValue(state, kControllerTrackingState, trackingState);
+  if (!snapshot)
+  {
+    return;
+  }
+
+  const float *data = snapshot->data;
+  input.DeviceState_SetAxis3DValue(state, kControllerPointerPosition, {data[kControllerDataPointerPosition],
+                                                                       data[kControllerDataPointerPosition + 1],
+                                                                       data[kControllerDataPointerPosition + 2]});
+  input.DeviceState_SetRotationValue(state, kControllerPointerRotation, {data[kControllerDataPointerRotation],
+                                                                         data[kControllerDataPointerRotation + 1],
+                                                                         data[kControllerDataPointerRotation + 2],
+                                                                         data[kControllerDataPointerRotation + 3]});
+
+  input.DeviceState_SetAxis1DValue(state, kControllerTrigger, data[kControllerDataTrigger]);
+  input.DeviceState_SetBinaryValue(state, kControllerTriggerButton, data[kControllerDataTrigger] > kButtonPressThreshold);
+  input.DeviceState_SetBinaryValue(state, kControllerTriggerTouch, data[kControllerDataTriggerTouched] != 0.0f);
+  input.DeviceState_SetAxis1DValue(state, kControllerGrip, data[kControllerDataSqueeze]);
+  input.DeviceState_SetBinaryValue(state, kControllerGripButton, data[kControllerDataSqueeze] > kButtonPressThreshold);
+  input.DeviceState_SetAxis2DValue(state, kControllerPrimary2DAxis, {data[kControllerDataThumbstickX], data[kControllerDataThumbstickY]});
+  input.DeviceState_SetBinaryValue(state, kControllerPrimary2DAxisClick, data[kControllerDataThumbstick] > kButtonPressThreshold);
+  input.DeviceState_SetBinaryValue(state, kControllerPrimary2DAxisTouch, data[kControllerDataThumbstickTouched] != 0.0f);
+  input.DeviceState_SetAxis2DValue(state, kControllerSecondary2DAxis, {data[kControllerDataTouchpadX], data[kControllerDataTouchpadY]});
+  input.DeviceState_SetBinaryValue(state, kControllerSecondary2DAxisClick, data[kControllerDataTouchpad] > kButtonPressThreshold);
+  input.DeviceState_SetBinaryValue(state, kControllerSecondary2DAxisTouch, data[kControllerDataTouchpadTouched] != 0.0f);
+  input.DeviceState_SetBinaryValue(state, kControllerPrimaryButton, data[kControllerDataButtonA] > kButtonPressThreshold);
+  input.DeviceState_SetBinaryValue(state, kControllerPrimaryTouch, data[kControllerDataButtonATouched] != 0.0f);
+  input.DeviceState_SetBinaryValue(state, kControllerSecondaryButton, data[kControllerDataButtonB] > kButtonPressThreshold);
+  input.DeviceState_SetBinaryValue(state, kControllerSecondaryTouch, data[kControllerDataButtonBTouched] != 0.0f);
+}
+
+void WebXRTrackingProvider::SetHandState(const UnityXRPose &pose, const HandSnapshot *snapshot, UnityXRInputDeviceState *state)
+{
+  auto &input = *m_Ctx.input;
+  input.DeviceState_SetAxis3DValue(state, kHandDevicePosition, pose.position);
+  input.DeviceState_SetRotationValue(state, kHandDeviceRotation, pose.rotation);
+
+  unsigned int trackingState = kUnityXRInputTrackingStatePosition | kUnityXRInputTrackingStateRotation;
+  if (snapshot && snapshot->motion.HasVelocity())
+  {
+    input.DeviceState_SetAxis3DValue(state, kHandDeviceVelocity, snapshot->motion.GetVelocity());
+    input.DeviceState_SetAxis3DValue(state, kHandDeviceAngularVelocity, snapshot->motion.GetAngularVelocity());
+    trackingState |= kUnityXRInputTrackingStateVelocity | kUnityXRInputTrackingStateAngularVelocity;
+  }
+  input.DeviceState_SetBinaryValue(state, kHandIsTracked, true);
+  input.DeviceState_SetDiscreteStateValue(state, kHandTrackingState, trackingState);
+  if (!snapshot)
+  {
+    return;
+  }
+
+  const float *data = snapshot->data;
+  input.DeviceState_SetAxis3DValue(state, kHandPointerPosition, {data[kHandDataPointerPosition],
+                                                                 data[kHandDataPointerPosition + 1],
+                                                                 data[kHandDataPointerPosition + 2]});
+  input.DeviceState_SetRotationValue(state, kHandPointerRotation, {data[kHandDataPointerRotation],
+                                                                   data[kHandDataPointerRotation + 1],
+                                                                   data[kHandDataPointerRotation + 2],
+                                                                   data[kHandDataPointerRotation + 3]});
+  input.DeviceState_SetAxis1DValue(state, kHandTrigger, data[kHandDataTrigger]);
+  input.DeviceState_SetBinaryValue(state, kHandTriggerButton, data[kHandDataTrigger] > kButtonPressThreshold);
+  input.DeviceState_SetAxis1DValue(state, kHandGrip, data[kHandDataSqueeze]);
+  input.DeviceState_SetBinaryValue(state, kHandGripButton, data[kHandDataSqueeze] > kButtonPressThreshold);
+
+  // The wrist is the root, each finger is a chain from its metacarpal, the thumb has no intermediate phalanx.
+  UnityXRHand handValue;
+  handValue.rootBoneIndex = kHandFirstBone;
+  int joint = 1;
+  for (int finger = 0; finger < UnityXRFingerCount; ++finger)
+  {
+    int fingerJoints = finger == UnityXRFingerThumb ? 4 : 5;
+    for (int bone = 0; bone < kUnityXRMaxFingerBoneCount; ++bone)
+    {
+      handValue.fingerBonesIndices[finger][bone] = bone < fingerJoints ? kHandFirstBone + joint + bone : kUnityInvalidXRInputFeatureIndex;
+    }
+    for (int bone = 0; bone < fingerJoints; ++bone)
+    {
+      const float *jointData = data + kHandDataJoints + (joint + bone) * kHandDataJointLength;
+      UnityXRBone boneValue;
+      boneValue.parentBoneIndex = bone == 0 ? kHandFirstBone : kHandFirstBone + joint + bone - 1;
+      boneValue.position = {jointData[0], jointData[1], jointData[2]};
+      boneValue.rotation = {jointData[3], jointData[4], jointData[5], jointData[6]};
+      input.DeviceState_SetBoneValue(state, kHandFirstBone + joint + bone, boneValue);
+    }
+    joint += fingerJoints;
+  }
+  UnityXRBone wrist;
+  wrist.parentBoneIndex = kUnityInvalidXRInputFeatureIndex;
+  wrist.position = pose.position;
+  wrist.rotation = pose.rotation;
+  input.DeviceState_SetBoneValue(state, kHandFirstBone, wrist);
+  input.DeviceState_SetHandValue(state, kHandHandData, handValue);
 }
 
 UnitySubsystemErrorCode WebXRTrackingProvider::HandleEvent(unsigned int eventType, UnityXRInternalInputDeviceId deviceId, void *buffer, unsigned int size)
@@ -140,18 +1015,154 @@ UnitySubsystemErrorCode WebXRTrackingProvider::HandleEvent(unsigned int eventTyp
 UnitySubsystemErrorCode WebXRTrackingProvider::TryGetDeviceStateAtTime(UnityXRTimeStamp time, UnityXRInternalInputDeviceId deviceId, UnityXRInputDeviceState *state)
 {
   /// Unity calls this when requesting a state at a specific time in the past
+  const Controller *controller = GetController(deviceId);
+  if (controller)
+  {
+    UnityXRPose controllerPose;
+    if (!controller->connected || !controller->history.Sample((double)time, controllerPose))
+    {
+      return kUnitySubsystemErrorCodeFailure;
+    }
+    SetControllerState(controllerPose, nullptr, state);
+    m_Ctx.input->DeviceState_SetDeviceTime(state, time);
+    return kUnitySubsystemErrorCodeSuccess;
+  }
+  const Hand *hand = GetHand(deviceId);
+  if (hand)
+  {
+    UnityXRPose handPose;
+    if (!hand->connected || !hand->history.Sample((double)time, handPose))
+    {
+      return kUnitySubsystemErrorCodeFailure;
+    }
+    SetHandState(handPose, nullptr, state);
+    m_Ctx.input->DeviceState_SetDeviceTime(state, time);
+    return kUnitySubsystemErrorCodeSuccess;
+  }
+  if (deviceId != kInputDeviceHMD)
+  {
+    return kUnitySubsystemErrorCodeFailure;
+  }
+  UnityXRPose pose;
+  if (!m_HMDHistory.Sample((double)time, pose))
+  {
+    return kUnitySubsystemErrorCodeFailure;
+  }
+  SetHMDState(pose, nullptr, state);
+  m_Ctx.input->DeviceState_SetDeviceTime(state, time);
+  return kUnitySubsystemErrorCodeSuccess;
+}
+
+UnitySubsystemErrorCode WebXRTrackingProvider::QueryHapticCapabilities(UnityXRInternalInputDeviceId deviceId, UnityXRHapticCapabilities *capabilities)
+{
+  if (!GetController(deviceId))
+  {
+    return kUnitySubsystemErrorCodeFailure;
+  }
+  // GamepadHapticActuator.pulse, no buffered haptics.
+  *capabilities = {};
+  capabilities->numChannels = 1;
+  capabilities->supportsImpulse = true;
+  return kUnitySubsystemErrorCodeSuccess;
+}
+
+UnitySubsystemErrorCode WebXRTrackingProvider::HandleHapticImpulse(UnityXRInternalInputDeviceId deviceId, int channel, float amplitude, float duration)
+{
+  Controller *controller = GetController(deviceId);
+  if (!controller || !controller->connected || channel != 0)
+  {
+    return kUnitySubsystemErrorCodeFailure;
+  }
+  // Unity durations are in seconds.
+  controller->haptics.Pulse(amplitude, duration * 1000.0f);
+  return kUnitySubsystemErrorCodeSuccess;
+}
+
+UnitySubsystemErrorCode WebXRTrackingProvider::HandleHapticStop(UnityXRInternalInputDeviceId deviceId)
+{
+  Controller *controller = GetController(deviceId);
+  if (!controller || !controller->connected)
+  {
+    return kUnitySubsystemErrorCodeFailure;
+  }
+  controller->haptics.Stop();
   return kUnitySubsystemErrorCodeSuccess;
 }
 
 void WebXRTrackingProvider::Stop()
 {
+  m_Running = false;
   m_Ctx.input->InputSubsystem_DeviceDisconnected(m_Handle, kInputDeviceHMD);
+  for (int i = 0; i < kControllersCount; ++i)
+  {
+    if (m_Controllers[i].connected)
+    {
+      m_Ctx.input->InputSubsystem_DeviceDisconnected(m_Handle, m_Controllers[i].deviceId);
+      m_Controllers[i].connected = false;
+    }
+    m_Controllers[i].haptics.Clear();
+  }
+  for (int i = 0; i < kHandsCount; ++i)
+  {
+    if (m_Hands[i].connected)
+    {
+      m_Ctx.input->InputSubsystem_DeviceDisconnected(m_Handle, m_Hands[i].deviceId);
+      m_Hands[i].connected = false;
+    }
+  }
 }
 
 void WebXRTrackingProvider::Shutdown()
 {
 }
 
+extern "C" void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API WebXRSetPosePrediction(bool enabled)
+{
+  s_PosePredictionEnabled = enabled;
+}
+
+extern "C" void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API WebXRSetNativeControllers(bool enabled)
+{
+  s_NativeControllersEnabled = enabled;
+}
+
+extern "C" void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API WebXRSetNativeHands(bool enabled)
+{
+  s_NativeHandsEnabled = enabled;
+}
+
+extern "C" void UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API WebXRSetPoseFilter(bool controllers, bool hands, float minCutoff, float beta, float derivativeCutoff)
+{
+  s_ControllerFilteringEnabled = controllers;
+  s_HandFilteringEnabled = hands;
+  s_PoseFilterParameters.minCutoff = minCutoff;
+  s_PoseFilterParameters.beta = beta;
+  s_PoseFilterParameters.derivativeCutoff = derivativeCutoff;
+}
+
+static WebXRProviderContext *s_InputContext{};
+
+// Read by WebXRHandsProvider in place of the managed hands array, null while the hand isn't tracked.
+extern "C" const float UNITY_INTERFACE_EXPORT *UNITY_INTERFACE_API WebXRGetNativeHandData(int hand)
+{
+  if (s_InputContext == nullptr || s_InputContext->trackingProvider == nullptr)
+  {
+    return nullptr;
+  }
+  return s_InputContext->trackingProvider->GetHandData(hand);
+}
+
+// WebXRSubsystem.HapticPulse, returns 0 when the input subsystem isn't running to flush the queue.
+extern "C" int UNITY_INTERFACE_EXPORT UNITY_INTERFACE_API WebXRQueueHapticPulse(int hand, float intensity, float duration)
+{
+  if (s_InputContext == nullptr || s_InputContext->trackingProvider == nullptr || !s_InputContext->trackingProvider->IsRunning())
+  {
+    return 0;
+  }
+  s_InputContext->trackingProvider->QueueHapticPulse(hand, intensity, duration);
+  return 1;
+}
+
 // Binding to C-API below here
 
 static UnitySubsystemErrorCode UNITY_INTERFACE_API Input_Initialize(UnitySubsystemHandle handle, void *userData)
@@ -159,6 +1170,7 @@ static UnitySubsystemErrorCode UNITY_INTERFACE_API Input_Initialize(UnitySubsyst
   auto &ctx = GetWebXRProviderContext(userData);
 
   ctx.trackingProvider = new WebXRTrackingProvider(ctx, handle);
+  s_InputContext = &ctx;
 
   UnityXRInputProvider inputProvider{};
   inputProvider.userData = &ctx;
@@ -193,6 +1205,24 @@ static UnitySubsystemErrorCode UNITY_INTERFACE_API Input_Initialize(UnitySubsyst
     return ctx.trackingProvider->TryGetDeviceStateAtTime(time, deviceId, state);
   };
 
+  inputProvider.QueryHapticCapabilities = [](UnitySubsystemHandle handle, void *userData, UnityXRInternalInputDeviceId deviceId, UnityXRHapticCapabilities *capabilities) -> UnitySubsystemErrorCode
+  {
+    auto &ctx = GetWebXRProviderContext(userData);
+    return ctx.trackingProvider->QueryHapticCapabilities(deviceId, capabilities);
+  };
+
+  inputProvider.HandleHapticImpulse = [](UnitySubsystemHandle handle, void *userData, UnityXRInternalInputDeviceId deviceId, int channel, float amplitude, float duration) -> UnitySubsystemErrorCode
+  {
+    auto &ctx = GetWebXRProviderContext(userData);
+    return ctx.trackingProvider->HandleHapticImpulse(deviceId, channel, amplitude, duration);
+  };
+
+  inputProvider.HandleHapticStop = [](UnitySubsystemHandle handle, void *userData, UnityXRInternalInputDeviceId deviceId) -> UnitySubsystemErrorCode
+  {
+    auto &ctx = GetWebXRProviderContext(userData);
+    return ctx.trackingProvider->HandleHapticStop(deviceId);
+  };
+
   ctx.input->RegisterInputProvider(handle, &inputProvider);
 
   return ctx.trackingProvider->Initialize();
@@ -227,6 +1257,7 @@ UnitySubsystemErrorCode Load_Input(WebXRProviderContext &ctx)
     ctx.trackingProvider->Shutdown();
 
     delete ctx.trackingProvider;
+    ctx.trackingProvider = nullptr;
   };
 
   return ctx.input->RegisterLifecycleProvider("WebXR Export", "WebXR Tracked Display", &inputLifecycleHandler);
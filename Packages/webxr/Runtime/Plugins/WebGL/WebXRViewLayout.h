@@ -0,0 +1,200 @@
+#pragma once
+
+#include "UnityHeaders/UnityXRTypes.h"
+
+// How the views are placed in the texture Unity renders them to.
+enum WebXRTextureLayout
+{
+    // Both views in one texture that covers the bounding rect of the viewports.
+    kWebXRTextureLayoutSideBySide = 0,
+    // Both views in the WebXR projection layer texture, at their place in the whole framebuffer.
+    kWebXRTextureLayoutFramebuffer = 1,
+    // One view per slice of a 2 slices texture array, what single-pass instanced shaders (URP) render to.
+    kWebXRTextureLayoutTextureArray = 2
+};
+
+// Where each view is in the XRWebGLLayer framebuffer, from the viewports webxr.jspre shares.
+// Browsers may pad the framebuffer, stack the views vertically or give them different sizes,
+// so the eye textures cover only the bounding rect of the viewports, each view at its exact place in it.
+// Has no Unity runtime dependencies so the layouts can be checked on the host.
+class WebXRViewLayout
+{
+public:
+    static const int kMaxViews = 2;
+
+    // viewports holds width, height, x and y in pixels for each view, with the GL bottom left origin.
+    // Views without a viewport split the framebuffer evenly, side by side.
+    void Update(const float* viewports, int viewsCount, float framebufferWidth, float framebufferHeight)
+    {
+        m_ViewsCount = viewsCount < 1 ? 1 : (viewsCount > kMaxViews ? kMaxViews : viewsCount);
+        m_FramebufferWidth = framebufferWidth > 0.0f ? framebufferWidth : 1.0f;
+        m_FramebufferHeight = framebufferHeight > 0.0f ? framebufferHeight : 1.0f;
+
+        bool hasViewports = true;
+        for (int view = 0; view < m_ViewsCount; ++view)
+        {
+            const float* viewport = viewports + view * 4;
+            m_Viewports[view].width = viewport[0];
+            m_Viewports[view].height = viewport[1];
+            m_Viewports[view].x = viewport[2];
+            m_Viewports[view].y = viewport[3];
+            hasViewports = hasViewports && viewport[0] > 0.0f && viewport[1] > 0.0f;
+        }
+        if (!hasViewports)
+        {
+            for (int view = 0; view < m_ViewsCount; ++view)
+            {
+                m_Viewports[view].width = m_FramebufferWidth / m_ViewsCount;
+                m_Viewports[view].height = m_FramebufferHeight;
+                m_Viewports[view].x = view * m_Viewports[view].width;
+                m_Viewports[view].y = 0.0f;
+            }
+        }
+
+        float left = m_Viewports[0].x;
+        float bottom = m_Viewports[0].y;
+        float right = m_Viewports[0].x + m_Viewports[0].width;
+        float top = m_Viewports[0].y + m_Viewports[0].height;
+        for (int view = 1; view < m_ViewsCount; ++view)
+        {
+            const UnityXRRectf& viewport = m_Viewports[view];
+            left = viewport.x < left ? viewport.x : left;
+            bottom = viewport.y < bottom ? viewport.y : bottom;
+            right = viewport.x + viewport.width > right ? viewport.x + viewport.width : right;
+            top = viewport.y + viewport.height > top ? viewport.y + viewport.height : top;
+        }
+        m_Bounds.x = left;
+        m_Bounds.y = bottom;
+        m_Bounds.width = right - left;
+        m_Bounds.height = top - bottom;
+    }
+
+    int GetViewsCount() const { return m_ViewsCount; }
+
+    // Size of the bounding rect of the views, in pixels.
+    int GetTextureWidth() const { return (int)(m_Bounds.width + 0.5f); }
+    int GetTextureHeight() const { return (int)(m_Bounds.height + 0.5f); }
+
+    // Size of the texture, or of each slice of the texture array, in pixels.
+    int GetTextureWidth(WebXRTextureLayout layout) const
+    {
+        switch (layout)
+        {
+        case kWebXRTextureLayoutFramebuffer:
+            return (int)(m_FramebufferWidth + 0.5f);
+        case kWebXRTextureLayoutTextureArray:
+            return (int)(GetSliceWidth() + 0.5f);
+        default:
+            return GetTextureWidth();
+        }
+    }
+
+    int GetTextureHeight(WebXRTextureLayout layout) const
+    {
+        switch (layout)
+        {
+        case kWebXRTextureLayoutFramebuffer:
+            return (int)(m_FramebufferHeight + 0.5f);
+        case kWebXRTextureLayoutTextureArray:
+            return (int)(GetSliceHeight() + 0.5f);
+        default:
+            return GetTextureHeight();
+        }
+    }
+
+    // 0 for a plain 2D texture.
+    int GetTextureArrayLength(WebXRTextureLayout layout) const
+    {
+        return layout == kWebXRTextureLayoutTextureArray ? kMaxViews : 0;
+    }
+
+    int GetTextureArraySlice(int view, WebXRTextureLayout layout) const
+    {
+        return layout == kWebXRTextureLayoutTextureArray ? view : 0;
+    }
+
+    // Rect of the view in the texture, or in its slice of the texture array, normalized.
+    UnityXRRectf GetViewRect(int view, WebXRTextureLayout layout) const
+    {
+        switch (layout)
+        {
+        case kWebXRTextureLayoutFramebuffer:
+            return GetFramebufferRect(view);
+        case kWebXRTextureLayoutTextureArray:
+        {
+            // Slices are as large as the largest view, each view is at the slice origin.
+            UnityXRRectf rect;
+            rect.x = 0.0f;
+            rect.y = 0.0f;
+            rect.width = m_Viewports[view].width / GetSliceWidth();
+            rect.height = m_Viewports[view].height / GetSliceHeight();
+            return rect;
+        }
+        default:
+            return GetViewRect(view);
+        }
+    }
+
+    // Rect of the view in the eye texture, normalized to the bounding rect.
+    UnityXRRectf GetViewRect(int view) const
+    {
+        const UnityXRRectf& viewport = m_Viewports[view];
+        UnityXRRectf rect;
+        rect.x = (viewport.x - m_Bounds.x) / m_Bounds.width;
+        rect.y = (viewport.y - m_Bounds.y) / m_Bounds.height;
+        rect.width = viewport.width / m_Bounds.width;
+        rect.height = viewport.height / m_Bounds.height;
+        return rect;
+    }
+
+    // Rect of the view in the framebuffer, normalized. Where the compositor samples the view.
+    UnityXRRectf GetFramebufferRect(int view) const
+    {
+        const UnityXRRectf& viewport = m_Viewports[view];
+        UnityXRRectf rect;
+        rect.x = viewport.x / m_FramebufferWidth;
+        rect.y = viewport.y / m_FramebufferHeight;
+        rect.width = viewport.width / m_FramebufferWidth;
+        rect.height = viewport.height / m_FramebufferHeight;
+        return rect;
+    }
+
+    // Part of a view rect Unity renders to: the app render viewport (XRSettings.renderViewportScale),
+    // shrunk further by the dynamic resolution scale, from the view origin.
+    static UnityXRRectf GetRenderRect(const UnityXRRectf& viewRect, const UnityXRRectf& renderViewport, float scale)
+    {
+        UnityXRRectf rect;
+        rect.x = viewRect.x + renderViewport.x * viewRect.width;
+        rect.y = viewRect.y + renderViewport.y * viewRect.height;
+        rect.width = renderViewport.width * scale * viewRect.width;
+        rect.height = renderViewport.height * scale * viewRect.height;
+        return rect;
+    }
+
+private:
+    float GetSliceWidth() const
+    {
+        float width = m_Viewports[0].width;
+        for (int view = 1; view < m_ViewsCount; ++view)
+        {
+            width = m_Viewports[view].width > width ? m_Viewports[view].width : width;
+        }
+        return width;
+    }
+
+    float GetSliceHeight() const
+    {
+        float height = m_Viewports[0].height;
+        for (int view = 1; view < m_ViewsCount; ++view)
+        {
+            height = m_Viewports[view].height > height ? m_Viewports[view].height : height;
+        }
+        return height;
+    }
+
+    int m_ViewsCount = 1;
+    float m_FramebufferWidth = 1.0f;
+    float m_FramebufferHeight = 1.0f;
+    UnityXRRectf m_Viewports[kMaxViews] = {};
+    UnityXRRectf m_Bounds = {0.0f, 0.0f, 1.0f, 1.0f};
+};
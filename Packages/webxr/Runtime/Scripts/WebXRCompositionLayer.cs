@@ -0,0 +1,148 @@
+using UnityEngine;
+
+namespace WebXR
+{
+  // Shows a render texture in a WebXR quad or cylinder layer during XR sessions,
+  // for static UI that should stay sharp without being rendered again every frame.
+  // Requires WebXRSettings.UseCompositionLayers.
+  public class WebXRCompositionLayer : MonoBehaviour
+  {
+    public enum LayerType
+    {
+      Quad = 0,
+      Cylinder = 1
+    }
+
+    [SerializeField]
+    private LayerType m_LayerType = LayerType.Quad;
+    [SerializeField]
+    private RenderTexture m_Texture = null;
+    [SerializeField, Tooltip("Quad width and height, in meters.")]
+    private Vector2 m_Size = Vector2.one;
+    [SerializeField, Tooltip("Cylinder radius, in meters.")]
+    private float m_Radius = 2f;
+    [SerializeField, Tooltip("Cylinder central angle, in degrees."), Range(1f, 360f)]
+    private float m_CentralAngle = 60f;
+    [SerializeField, Tooltip("The XR camera parent when not set.")]
+    private Transform m_TrackingSpace = null;
+
+    private static int s_NextId = 1;
+
+    private int m_Id = 0;
+    private bool m_Created = false;
+    private Vector3 m_LastPosition;
+    private Quaternion m_LastRotation;
+
+    public RenderTexture Texture
+    {
+      get { return m_Texture; }
+      set
+      {
+        m_Texture = value;
+        MarkDirty();
+      }
+    }
+
+    // Call after rendering to the texture, the layer keeps its last copy otherwise.
+    public void MarkDirty()
+    {
+      if (m_Created && m_Texture != null)
+      {
+        WebXRManager.Instance.MarkCompositionLayerDirty(m_Id, m_Texture);
+      }
+    }
+
+    public void UpdateShape()
+    {
+      if (!m_Created)
+      {
+        return;
+      }
+      if (m_LayerType == LayerType.Cylinder)
+      {
+        WebXRManager.Instance.SetCompositionLayerShape(m_Id, m_Radius, m_CentralAngle * Mathf.Deg2Rad,
+                                                       (float)m_Texture.width / m_Texture.height);
+      }
+      else
+      {
+        WebXRManager.Instance.SetCompositionLayerShape(m_Id, m_Size.x, m_Size.y, 0f);
+      }
+    }
+
+    private void Awake()
+    {
+      m_Id = s_NextId++;
+    }
+
+    private void OnEnable()
+    {
+      WebXRManager.OnXRChange += OnXRChange;
+      OnXRChange(WebXRManager.Instance.XRState,
+                  WebXRManager.Instance.ViewsCount,
+                  WebXRManager.Instance.ViewsLeftRect,
+                  WebXRManager.Instance.ViewsRightRect);
+    }
+
+    private void OnDisable()
+    {
+      WebXRManager.OnXRChange -= OnXRChange;
+      DestroyLayer();
+    }
+
+    private void LateUpdate()
+    {
+      if (!m_Created)
+      {
+        return;
+      }
+      if (transform.position != m_LastPosition || transform.rotation != m_LastRotation)
+      {
+        UpdatePose();
+      }
+    }
+
+    private void OnXRChange(WebXRState state, int viewsCount, Rect leftRect, Rect rightRect)
+    {
+      if (state == WebXRState.NORMAL)
+      {
+        // The session releases its layers when it ends.
+        m_Created = false;
+      }
+      else if (!m_Created && m_Texture != null)
+      {
+        m_Created = WebXRManager.Instance.CreateCompositionLayer(m_Id, (int)m_LayerType, m_Texture);
+        UpdateShape();
+        if (m_Created)
+        {
+          UpdatePose();
+        }
+      }
+    }
+
+    private void DestroyLayer()
+    {
+      if (m_Created)
+      {
+        WebXRManager.Instance.DestroyCompositionLayer(m_Id);
+        m_Created = false;
+      }
+    }
+
+    private void UpdatePose()
+    {
+      if (m_TrackingSpace == null && Camera.main != null)
+      {
+        m_TrackingSpace = Camera.main.transform.parent;
+      }
+      m_LastPosition = transform.position;
+      m_LastRotation = transform.rotation;
+      var pose = new Pose(m_LastPosition, m_LastRotation);
+      if (m_TrackingSpace != null)
+      {
+        pose = new Pose(m_TrackingSpace.InverseTransformPoint(m_LastPosition),
+                        Quaternion.Inverse(m_TrackingSpace.rotation) * m_LastRotation);
+      }
+      WebXRManager.Instance.SetCompositionLayerPose(m_Id, pose);
+    }
+  }
+}
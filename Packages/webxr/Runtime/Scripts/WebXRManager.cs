@@ -21,6 +21,8 @@ namespace WebXR
 
     public static WebXRManager Instance { get; private set; }
 
+    private System.IntPtr gpuTimerPassEventFunc = System.IntPtr.Zero;
+
     public WebXRState XRState => subsystem == null ? WebXRState.NORMAL : subsystem.xrState;
     public int ViewsCount => subsystem == null ? 1 : subsystem.viewsCount;
     public Rect ViewsLeftRect => subsystem == null ? defaultRect : subsystem.leftRect;
@@ -50,6 +52,13 @@ namespace WebXR
       remove => WebXRSubsystem.OnControllerUpdate -= value;
     }
 
+    // controller1 is the right controller, controller2 the left one.
+    public static event WebXRSubsystem.InputProfilesUpdate OnInputProfilesUpdate
+    {
+      add => WebXRSubsystem.OnInputProfilesUpdate += value;
+      remove => WebXRSubsystem.OnInputProfilesUpdate -= value;
+    }
+
     public static event WebXRSubsystem.HandUpdate OnHandUpdate
     {
       add => WebXRSubsystem.OnHandUpdate += value;
@@ -123,6 +132,41 @@ namespace WebXR
       subsystem?.PreRenderSpectatorCamera();
     }
 
+    public void SetSpectatorView(bool enabled, Pose pose, float fieldOfView, float aspect, float resolutionScale)
+    {
+      subsystem?.SetSpectatorView(enabled, pose, fieldOfView, aspect, resolutionScale);
+    }
+
+    public bool CreateCompositionLayer(int id, int type, RenderTexture texture)
+    {
+      return subsystem != null && subsystem.CreateCompositionLayer(id, type, texture);
+    }
+
+    public void SetCompositionLayerPose(int id, Pose pose)
+    {
+      subsystem?.SetCompositionLayerPose(id, pose);
+    }
+
+    public void SetCompositionLayerShape(int id, float a, float b, float c)
+    {
+      subsystem?.SetCompositionLayerShape(id, a, b, c);
+    }
+
+    public void MarkCompositionLayerDirty(int id, RenderTexture texture)
+    {
+      subsystem?.MarkCompositionLayerDirty(id, texture);
+    }
+
+    public void DestroyCompositionLayer(int id)
+    {
+      subsystem?.DestroyCompositionLayer(id);
+    }
+
+    public System.IntPtr GetNativeHandData(int hand)
+    {
+      return subsystem != null ? subsystem.GetNativeHandData(hand) : System.IntPtr.Zero;
+    }
+
     public void StartViewerHitTest()
     {
       subsystem?.StartViewerHitTest();
@@ -157,9 +201,35 @@ namespace WebXR
       enabled = subsystem != null;
     }
 
+    protected override void OnEnable()
+    {
+      base.OnEnable();
+      gpuTimerPassEventFunc = subsystem != null ? subsystem.GetGpuTimerPassEventFunc() : System.IntPtr.Zero;
+      if (gpuTimerPassEventFunc != System.IntPtr.Zero)
+      {
+        Camera.onPreRender += OnCameraPreRender;
+      }
+    }
+
+    private void OnDisable()
+    {
+      Camera.onPreRender -= OnCameraPreRender;
+    }
+
     private void Update()
     {
       subsystem.OnUpdate();
     }
+
+    // The built-in render pipeline renders each pass of the XR frame as its own camera render,
+    // the event starts the GPU time of the next pass. Render pipelines have no per pass callback,
+    // their whole frame is counted as the first pass.
+    private void OnCameraPreRender(Camera camera)
+    {
+      if (camera.stereoEnabled)
+      {
+        GL.IssuePluginEvent(gpuTimerPassEventFunc, 0);
+      }
+    }
   }
 }
@@ -17,6 +17,8 @@ namespace WebXR
     public XRDisplaySubsystem XRDisplaySubsystem => GetLoadedSubsystem<XRDisplaySubsystem>();
     public XRInputSubsystem XRInputSubsystem => GetLoadedSubsystem<XRInputSubsystem>();
     private bool useXRDisplaySubsystem = true;
+    private bool useSinglePassRendering = false;
+    private bool useOcclusionMesh = false;
 
 #if UNITY_WEBGL && !UNITY_EDITOR
     [DllImport("__Internal")]
@@ -24,6 +26,33 @@ namespace WebXR
 
     [DllImport("__Internal")]
     private static extern void RegisterWebXRPlugin();
+
+    [DllImport("__Internal")]
+    private static extern void WebXRSetDynamicResolution(bool enabled, float minScale);
+
+    [DllImport("__Internal")]
+    private static extern void WebXRSetSinglePassTextureArray(bool enabled);
+
+    [DllImport("__Internal")]
+    private static extern void WebXRSetFoveatedRendering(bool enabled, float innerSize, float outerScale);
+
+    [DllImport("__Internal")]
+    private static extern void WebXRSetAutomaticPerformance(bool enabled);
+
+    [DllImport("__Internal")]
+    private static extern void WebXRSetCanvasMirrorMode(int mode);
+
+    [DllImport("__Internal")]
+    private static extern void WebXRSetPosePrediction(bool enabled);
+
+    [DllImport("__Internal")]
+    private static extern void WebXRSetNativeControllers(bool enabled);
+
+    [DllImport("__Internal")]
+    private static extern void WebXRSetNativeHands(bool enabled);
+
+    [DllImport("__Internal")]
+    private static extern void WebXRSetPoseFilter(bool controllers, bool hands, float minCutoff, float beta, float derivativeCutoff);
 #endif
 
     public override bool Initialize()
@@ -40,8 +69,22 @@ namespace WebXR
 #endif
         Debug.Log($"Sent WebXRSettings");
         useXRDisplaySubsystem = !settings.DisableXRDisplaySubsystem;
+        useSinglePassRendering = settings.UseSinglePassRendering;
+        useOcclusionMesh = settings.UseOcclusionMesh;
+#if UNITY_WEBGL && !UNITY_EDITOR
+        WebXRSetSinglePassTextureArray(settings.UseSinglePassTextureArray);
+        WebXRSetDynamicResolution(settings.UseDynamicResolution, settings.DynamicResolutionMinScale);
+        WebXRSetFoveatedRendering(settings.UseFoveatedRendering, settings.FoveatedInnerSize, settings.FoveatedOuterScale);
+        WebXRSetAutomaticPerformance(settings.UseAutomaticPerformance);
+        WebXRSetCanvasMirrorMode((int)settings.CanvasMirrorMode);
+        WebXRSetPosePrediction(settings.UsePosePrediction);
+        WebXRSetNativeControllers(settings.UseNativeControllers);
+        WebXRSetNativeHands(settings.UseNativeHands);
+        WebXRSetPoseFilter(settings.FilterControllerPoses, settings.FilterHandJoints,
+                           settings.PoseFilterMinCutoff, settings.PoseFilterBeta, settings.PoseFilterDerivativeCutoff);
+#endif
       }
-      XRSettings.useOcclusionMesh = false;
+      XRSettings.useOcclusionMesh = useOcclusionMesh;
       CreateSubsystem<WebXRSubsystemDescriptor, WebXRSubsystem>(sampleSubsystemDescriptors, typeof(WebXRSubsystem).FullName);
       return WebXRSubsystem != null;
     }
@@ -50,13 +93,16 @@ namespace WebXR
     {
       if (useXRDisplaySubsystem)
       {
-        CreateSubsystem<XRDisplaySubsystemDescriptor, XRDisplaySubsystem>(displaySubsystemDescriptors, "WebXR Display");
+        // The display subsystem is kept between sessions, so its render textures can be reused.
+        if (XRDisplaySubsystem == null)
+        {
+          CreateSubsystem<XRDisplaySubsystemDescriptor, XRDisplaySubsystem>(displaySubsystemDescriptors, "WebXR Display");
+        }
+        XRDisplaySubsystem.singlePassRenderingDisabled = !useSinglePassRendering;
         XRDisplaySubsystem.Start();
       }
       CreateSubsystem<XRInputSubsystemDescriptor, XRInputSubsystem>(inputSubsystemDescriptors, "WebXR Tracked Display");
       XRInputSubsystem.Start();
-      // TODO: Enable Single-Pass rendering
-      // Debug.LogError(XRDisplaySubsystem.supportedTextureLayouts);
     }
 
     public void EndEssentialSubsystems()
@@ -64,7 +110,6 @@ namespace WebXR
       if (useXRDisplaySubsystem)
       {
         XRDisplaySubsystem.Stop();
-        XRDisplaySubsystem.Destroy();
       }
       XRInputSubsystem.Stop();
       XRInputSubsystem.Destroy();
@@ -24,6 +24,15 @@ namespace WebXR
       hand_tracking = 2
     }
 
+    // Must match WebXRCanvasMirrorMode in WebXRCanvasMirror.h
+    public enum CanvasMirrorModes
+    {
+      None = 0,
+      LeftEye = 1,
+      BothEyes = 2,
+      Cropped = 3
+    }
+
     [Header("VR Settings")]
     public ReferenceSpaceTypes VRRequiredReferenceSpace = ReferenceSpaceTypes.local_floor;
     public ExtraFeatureTypes VROptionalFeatures = ExtraFeatureTypes.hand_tracking;
@@ -55,6 +64,79 @@ Disabling it can allow the use of BiRP,
 but it's less convenient as it means using a list of Cameras instead of 1.
 If XRDisplaySubsystem is disabled use the WebXRCamera component.")]
     public bool DisableXRDisplaySubsystem = false;
+    [Tooltip(@"Should XRDisplaySubsystem render both eyes in a single pass?
+Requires a render pipeline and browser that support single-pass stereo.
+Falls back to multi-pass when the session has a single view.")]
+    public bool UseSinglePassRendering = false;
+    [Tooltip(@"If ""Use Single Pass Rendering"" is true, should both eyes render into the slices of a texture array?
+Single-pass instanced render pipelines (URP) need it. Otherwise both eyes render side by side in one texture.
+Not used when rendering to the projection layer.")]
+    public bool UseSinglePassTextureArray = false;
+    [Tooltip(@"Should XRDisplaySubsystem skip shading the pixels outside of the lens visible area?
+WebXR doesn't expose the lens shape, the visible area is approximated from each eye projection.
+Used only in sessions with two views.")]
+    public bool UseOcclusionMesh = false;
+    [Tooltip(@"Should XRDisplaySubsystem lower the eye textures resolution when frames run late,
+and raise it back when there's headroom?")]
+    public bool UseDynamicResolution = false;
+    [Tooltip(@"If ""Use Dynamic Resolution"" is true, what is the lowest scale of the eye textures resolution?")]
+    [Range(0.2f,1.0f)]
+    public float DynamicResolutionMinScale = 0.5f;
+    [Tooltip(@"Should XRDisplaySubsystem render directly into the WebXR projection layer texture?
+Saves a copy to the XRWebGLLayer framebuffer. Requires a browser that supports WebXR Layers,
+falls back to XRWebGLLayer otherwise. Dynamic resolution is not used in this mode.")]
+    public bool RenderToProjectionLayer = false;
+    [Tooltip(@"Should XRDisplaySubsystem render the center of each eye at full resolution,
+and the rest of the eye view at a reduced resolution?
+Used only with multi-pass rendering, and not when rendering to the projection layer.")]
+    public bool UseFoveatedRendering = false;
+    [Tooltip(@"If ""Use Foveated Rendering"" is true, what part of each eye view width and height is rendered at full resolution?")]
+    [Range(0.2f,0.8f)]
+    public float FoveatedInnerSize = 0.5f;
+    [Tooltip(@"If ""Use Foveated Rendering"" is true, what is the resolution scale of the rest of the eye view?")]
+    [Range(0.25f,1.0f)]
+    public float FoveatedOuterScale = 0.5f;
+    [Tooltip(@"Should XRDisplaySubsystem raise the compositor fixed foveation, then lower the session frame rate,
+when frames run late and dynamic resolution can't go lower? Both are restored when there's headroom.
+Only on browsers that support XRWebGLLayer.fixedFoveation and XRSession.updateTargetFrameRate.")]
+    public bool UseAutomaticPerformance = false;
+    [Tooltip(@"Should XRDisplaySubsystem copy the eye views to the page canvas during XR sessions?
+LeftEye and BothEyes stretch the views to the canvas, Cropped crops the left eye to the canvas aspect.
+Skipped when rendering to the projection layer, and while a spectator view is rendered.")]
+    public CanvasMirrorModes CanvasMirrorMode = CanvasMirrorModes.None;
+    [Tooltip(@"Should WebXRCompositionLayer components show their render textures in quad and cylinder layers?
+The compositor samples them directly, so text and UI stay sharp and are not rendered again every frame.
+Requires a browser that supports WebXR Layers, the components stay disabled otherwise.")]
+    public bool UseCompositionLayers = false;
+    [Tooltip(@"Should XRInputSubsystem extrapolate the headset pose from the XR frame time to its predicted display time?
+Uses the velocities estimated from consecutive XR frames. Most browsers already predict the viewer pose,
+enable it only for browsers that report poses at the XR frame time. Applied to the BeforeRender input update only.")]
+    public bool UsePosePrediction = false;
+    [Tooltip(@"Should XRInputSubsystem expose the WebXR controllers as native XR controllers?
+They get the standard usages (Trigger, Grip, Primary2DAxis, PrimaryButton, DevicePosition...), and WebXRInputSystem
+stops creating its own controller devices. Existing bindings to the WebXR controller layout need to move to XR controllers.")]
+    public bool UseNativeControllers = false;
+    [Tooltip(@"Should XRInputSubsystem expose the WebXR hands as native XR hand tracking devices?
+They get the 25 WebXR joints as hand bones, the wrist as the device pose, and pinch and squeeze as Trigger and Grip.
+WebXRHandsProvider then reads the joints from the same native copy of the XR frame.")]
+    public bool UseNativeHands = false;
+    [Tooltip(@"Should the controllers pointer and grip poses be smoothed with a One Euro filter, once per XR frame?
+Filtered in the shared controllers data, so WebXRManager controller updates and native XR controllers get the same poses.")]
+    public bool FilterControllerPoses = false;
+    [Tooltip(@"Should the hands pointer pose and the 25 joints of each hand be smoothed with a One Euro filter, once per XR frame?
+Filtered in the shared hands data, so WebXRManager hand updates, native hands and XR Hands get the same joints.")]
+    public bool FilterHandJoints = false;
+    [Tooltip(@"If filtering poses, what is the cutoff frequency at rest, in Hz?
+Lower removes more jitter, and adds more lag to slow motions.")]
+    [Range(0.01f,10.0f)]
+    public float PoseFilterMinCutoff = 1.0f;
+    [Tooltip(@"If filtering poses, how fast does the cutoff frequency rise with the speed, in Hz per m/s or rad/s?
+Higher reduces the lag of fast motions.")]
+    [Range(0.0f,20.0f)]
+    public float PoseFilterBeta = 5.0f;
+    [Tooltip(@"If filtering poses, what is the cutoff frequency of the speed estimate, in Hz?")]
+    [Range(0.01f,10.0f)]
+    public float PoseFilterDerivativeCutoff = 1.0f;
 
     string EnumToString<T>(T value) where T : Enum
     {
@@ -92,7 +174,9 @@ If XRDisplaySubsystem is disabled use the WebXRCamera component.")]
         ""AROptionalFeatures"": {FlagsToString(AROptionalFeatures)},
         ""UseFramebufferScaleFactor"": {(UseFramebufferScaleFactor ? "true" : "false")},
         ""UseNativeResolution"": {(UseNativeResolution ? "true" : "false")},
-        ""FramebufferScaleFactor"": {FramebufferScaleFactor}
+        ""FramebufferScaleFactor"": {FramebufferScaleFactor},
+        ""RenderToProjectionLayer"": {(RenderToProjectionLayer && !DisableXRDisplaySubsystem ? "true" : "false")},
+        ""UseCompositionLayers"": {(UseCompositionLayers && !DisableXRDisplaySubsystem ? "true" : "false")}
 }}";
       return result;
     }
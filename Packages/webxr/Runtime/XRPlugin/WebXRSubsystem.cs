@@ -1,3 +1,4 @@
+using System;
 using System.Runtime.InteropServices;
 using AOT;
 using UnityEngine;
@@ -284,9 +285,69 @@ namespace WebXR
       [DllImport("__Internal")]
       public static extern void ControllerPulse(int controller, float intensity, float duration);
 
+      [DllImport("__Internal")]
+      public static extern int WebXRQueueHapticPulse(int hand, float intensity, float duration);
+
       [DllImport("__Internal")]
       public static extern void PreRenderSpectatorCamera();
 
+      [DllImport("__Internal")]
+      public static extern void WebXRGetTexturePoolStats(out uint hits, out uint misses);
+
+      [DllImport("__Internal")]
+      public static extern void WebXRGetDisplayStats(out int droppedFrameCount, out int framePresentCount,
+        out float refreshRate, out float motionToPhoton, out float gpuFrameTime);
+
+      [DllImport("__Internal")]
+      public static extern IntPtr WebXRGetGpuTimerPassEventFunc();
+
+      [DllImport("__Internal")]
+      public static extern int WebXRGetSupportedFrameRates(float[] frameRates, int maxCount);
+
+      [DllImport("__Internal")]
+      public static extern void WebXRSetFixedFoveation(float level);
+
+      [DllImport("__Internal")]
+      public static extern float WebXRGetFixedFoveation();
+
+      [DllImport("__Internal")]
+      public static extern void WebXRSetTargetFrameRate(float frameRate);
+
+      [DllImport("__Internal")]
+      public static extern float WebXRGetTargetFrameRate();
+
+      [DllImport("__Internal")]
+      public static extern void WebXRSetAutomaticPerformance(bool enabled);
+
+      [DllImport("__Internal")]
+      public static extern void WebXRSetCanvasMirrorMode(int mode);
+
+      [DllImport("__Internal")]
+      public static extern void WebXRSetSpectatorView(bool enabled,
+          float positionX, float positionY, float positionZ,
+          float rotationX, float rotationY, float rotationZ, float rotationW,
+          float fieldOfView, float aspect, float resolutionScale);
+
+      [DllImport("__Internal")]
+      public static extern int WebXRCreateCompositionLayer(int id, int type, uint textureName, int textureWidth, int textureHeight);
+
+      [DllImport("__Internal")]
+      public static extern void WebXRSetCompositionLayerPose(int id,
+          float positionX, float positionY, float positionZ,
+          float rotationX, float rotationY, float rotationZ, float rotationW);
+
+      [DllImport("__Internal")]
+      public static extern void WebXRSetCompositionLayerShape(int id, float a, float b, float c);
+
+      [DllImport("__Internal")]
+      public static extern void WebXRMarkCompositionLayerDirty(int id, uint textureName);
+
+      [DllImport("__Internal")]
+      public static extern void WebXRDestroyCompositionLayer(int id);
+
+      [DllImport("__Internal")]
+      public static extern IntPtr WebXRGetNativeHandData(int hand);
+
       [DllImport("__Internal")]
       public static extern void SetWebXREvents(StartXREvent on_start_ar,
           StartXREvent on_start_vr,
@@ -332,6 +393,10 @@ namespace WebXR
 
     internal static event ControllerUpdate OnControllerUpdate;
 
+    public delegate void InputProfilesUpdate(WebXRControllersProfiles controllersProfiles);
+
+    internal static event InputProfilesUpdate OnInputProfilesUpdate;
+
     public delegate void HandUpdate(WebXRHandData handData);
 
     internal static event HandUpdate OnHandUpdate;
@@ -360,8 +425,10 @@ namespace WebXR
 
     // Shared array which we will load headset data in from webxr.jslib
     // Array stores 2 matrices, each 16 values, 2 Quaternions and 2 Vector3,
-    // 2 XRViewports, views count, is transparent, framebuffer width height, stored linearly.
-    float[] sharedArray = new float[(2 * 16) + (2 * 7) + (2 * 4) + 1 + 1 + 2];
+    // 2 XRViewports, views count, is transparent, framebuffer width height,
+    // projection layer texture, frame number, frame time, predicted display time
+    // and frame rate, stored linearly.
+    float[] sharedArray = new float[(2 * 16) + (2 * 7) + (2 * 4) + 1 + 1 + 2 + 1 + 1 + 3];
 
     // Shared array for controllers data
     float[] controllersArray = new float[2 * 34];
@@ -412,6 +479,7 @@ namespace WebXR
     {
       controller1.profiles = controllersProfiles.controller1;
       controller2.profiles = controllersProfiles.controller2;
+      OnInputProfilesUpdate?.Invoke(controllersProfiles);
     }
 
     public void setXrState(WebXRState state, int viewsCount, Rect leftRect, Rect rightRect)
@@ -514,10 +582,19 @@ namespace WebXR
 #endif
     }
 
+    // duration in milliseconds. Queued in WebXR Tracked Display and sent on the next XR frame,
+    // merged with the other pulses of the frame into one GamepadHapticActuator.pulse call.
     public void HapticPulse(WebXRControllerHand hand, float intensity, float duration)
     {
 #if UNITY_WEBGL
-      Native.ControllerPulse((int)hand, intensity, duration);
+      if (xrState == WebXRState.NORMAL)
+      {
+        return;
+      }
+      if (Native.WebXRQueueHapticPulse((int)hand, intensity, duration) == 0)
+      {
+        Native.ControllerPulse((int)hand, intensity, duration);
+      }
 #endif
     }
 
@@ -528,6 +605,178 @@ namespace WebXR
 #endif
     }
 
+    // Render textures requests of the WebXR Display, served from its pool (hits) or newly allocated (misses).
+    public void GetTexturePoolStats(out uint hits, out uint misses)
+    {
+#if UNITY_WEBGL
+      Native.WebXRGetTexturePoolStats(out hits, out misses);
+#else
+      hits = 0;
+      misses = 0;
+#endif
+    }
+
+    // Stats of the WebXR Display frames: frames dropped since the session started, refreshes the previous frame
+    // stayed on the display, display refresh rate, motion-to-photon latency and GPU frame time, both in seconds.
+    // The GPU frame time is 0 when the browser has no EXT_disjoint_timer_query_webgl2.
+    public void GetDisplayStats(out int droppedFrameCount, out int framePresentCount,
+      out float refreshRate, out float motionToPhoton, out float gpuFrameTime)
+    {
+#if UNITY_WEBGL
+      Native.WebXRGetDisplayStats(out droppedFrameCount, out framePresentCount,
+        out refreshRate, out motionToPhoton, out gpuFrameTime);
+#else
+      droppedFrameCount = 0;
+      framePresentCount = 0;
+      refreshRate = 0;
+      motionToPhoton = 0;
+      gpuFrameTime = 0;
+#endif
+    }
+
+    // Render event for GL.IssuePluginEvent, issued before each render pass of the XR camera.
+    // The GPU time from there on is counted for the next pass of the frame, see XRStats GPUAppLastFrameTimePass<index>.
+    public IntPtr GetGpuTimerPassEventFunc()
+    {
+#if UNITY_WEBGL
+      return Native.WebXRGetGpuTimerPassEventFunc();
+#else
+      return IntPtr.Zero;
+#endif
+    }
+
+    // With WebXRSettings.UseNativeHands, the hand block of the latched XR frame for hand 1 (left) or 2 (right),
+    // laid out like the hands array. Zero while the hand isn't tracked. Valid until the next XR frame.
+    public IntPtr GetNativeHandData(int hand)
+    {
+#if UNITY_WEBGL
+      return Native.WebXRGetNativeHandData(hand);
+#else
+      return IntPtr.Zero;
+#endif
+    }
+
+    // XRSession.supportedFrameRates of the current session, in ascending order. Empty when the browser doesn't expose them.
+    public float[] GetSupportedFrameRates()
+    {
+#if UNITY_WEBGL
+      float[] frameRates = new float[8];
+      int count = Native.WebXRGetSupportedFrameRates(frameRates, frameRates.Length);
+      Array.Resize(ref frameRates, count);
+      return frameRates;
+#else
+      return new float[0];
+#endif
+    }
+
+    // Compositor fixed foveation, from 0 (none) to 1 (most). Applied on the next frame, or when the next session starts,
+    // ignored by browsers without XRWebGLLayer.fixedFoveation.
+    public void SetFixedFoveation(float level)
+    {
+#if UNITY_WEBGL
+      Native.WebXRSetFixedFoveation(level);
+#endif
+    }
+
+    public float GetFixedFoveation()
+    {
+#if UNITY_WEBGL
+      return Native.WebXRGetFixedFoveation();
+#else
+      return 0;
+#endif
+    }
+
+    // Requests the closest of the supported frame rates. Applied on the next frame, or when the next session starts.
+    public void SetTargetFrameRate(float frameRate)
+    {
+#if UNITY_WEBGL
+      Native.WebXRSetTargetFrameRate(frameRate);
+#endif
+    }
+
+    // 0 until the session frame rate is known.
+    public float GetTargetFrameRate()
+    {
+#if UNITY_WEBGL
+      return Native.WebXRGetTargetFrameRate();
+#else
+      return 0;
+#endif
+    }
+
+    // Should foveation and frame rate be adjusted to frame times, once dynamic resolution can't go lower?
+    public void SetAutomaticPerformance(bool enabled)
+    {
+#if UNITY_WEBGL
+      Native.WebXRSetAutomaticPerformance(enabled);
+#endif
+    }
+
+    // Copies the eye views rendered for the headset to the page canvas, for the cost of a blit.
+    public void SetCanvasMirrorMode(WebXRSettings.CanvasMirrorModes mode)
+    {
+#if UNITY_WEBGL
+      Native.WebXRSetCanvasMirrorMode((int)mode);
+#endif
+    }
+
+    // Renders a spectator view as an extra pass of the XR frame, and shows it on the page canvas.
+    // pose is relative to the XR camera, and should be set every frame. fieldOfView is vertical, in degrees.
+    public void SetSpectatorView(bool enabled, Pose pose, float fieldOfView, float aspect, float resolutionScale)
+    {
+#if UNITY_WEBGL
+      Native.WebXRSetSpectatorView(enabled,
+          pose.position.x, pose.position.y, pose.position.z,
+          pose.rotation.x, pose.rotation.y, pose.rotation.z, pose.rotation.w,
+          fieldOfView, aspect, resolutionScale);
+#endif
+    }
+
+    // Shows texture in a quad (type 0) or cylinder (type 1) WebXR composition layer, during the current XR session.
+    // Returns false when the browser or the settings don't allow composition layers.
+    public bool CreateCompositionLayer(int id, int type, RenderTexture texture)
+    {
+#if UNITY_WEBGL
+      return Native.WebXRCreateCompositionLayer(id, type, (uint)texture.GetNativeTexturePtr(), texture.width, texture.height) != 0;
+#else
+      return false;
+#endif
+    }
+
+    // pose is in the XR tracking space.
+    public void SetCompositionLayerPose(int id, Pose pose)
+    {
+#if UNITY_WEBGL
+      Native.WebXRSetCompositionLayerPose(id,
+          pose.position.x, pose.position.y, pose.position.z,
+          pose.rotation.x, pose.rotation.y, pose.rotation.z, pose.rotation.w);
+#endif
+    }
+
+    // Quad: width and height in meters, c is unused. Cylinder: radius in meters, central angle in radians and aspect ratio.
+    public void SetCompositionLayerShape(int id, float a, float b, float c)
+    {
+#if UNITY_WEBGL
+      Native.WebXRSetCompositionLayerShape(id, a, b, c);
+#endif
+    }
+
+    // The layer texture is copied again at the end of the next XR frame.
+    public void MarkCompositionLayerDirty(int id, RenderTexture texture)
+    {
+#if UNITY_WEBGL
+      Native.WebXRMarkCompositionLayerDirty(id, (uint)texture.GetNativeTexturePtr());
+#endif
+    }
+
+    public void DestroyCompositionLayer(int id)
+    {
+#if UNITY_WEBGL
+      Native.WebXRDestroyCompositionLayer(id);
+#endif
+    }
+
     void GetMatrixFromSharedArray(int index, ref Matrix4x4 matrix)
     {
       for (int i = 0; i < 16; i++)
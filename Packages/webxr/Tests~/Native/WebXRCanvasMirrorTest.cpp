@@ -0,0 +1,101 @@
+#include "WebXRCanvasMirror.h"
+#include "WebXRTestUtils.h"
+
+static const UnityXRRectf kFullRect = {0.0f, 0.0f, 1.0f, 1.0f};
+// Side by side square eyes in a 2:1 texture.
+static const UnityXRRectf kSideBySideEyes[] = {{0.0f, 0.0f, 0.5f, 1.0f}, {0.5f, 0.0f, 0.5f, 1.0f}};
+static const float kSideBySideAspect = 2.0f;
+// One slice per eye of a texture array.
+static const UnityXRRectf kArrayEyes[] = {kFullRect, kFullRect};
+// Landscape, square and portrait canvases.
+static const float kCanvasAspects[] = {16.0f / 9.0f, 1.0f, 9.0f / 16.0f};
+
+static void TestLeftEye()
+{
+    WebXRCanvasMirrorBlit blits[WebXRCanvasMirror::kMaxBlits];
+    // The whole left eye stretched over the canvas, whatever its aspect.
+    for (float canvasAspect : kCanvasAspects)
+    {
+        assert(WebXRCanvasMirror::GetBlits(kWebXRCanvasMirrorLeftEye, kSideBySideEyes, 2, kSideBySideAspect, canvasAspect, blits) == 1);
+        assert(blits[0].view == 0);
+        assert(IsNearRect(blits[0].srcRect, kSideBySideEyes[0]));
+        assert(IsNearRect(blits[0].destRect, kFullRect));
+
+        assert(WebXRCanvasMirror::GetBlits(kWebXRCanvasMirrorLeftEye, kArrayEyes, 2, 1.0f, canvasAspect, blits) == 1);
+        assert(blits[0].view == 0);
+        assert(IsNearRect(blits[0].srcRect, kFullRect));
+    }
+}
+
+static void TestBothEyes()
+{
+    WebXRCanvasMirrorBlit blits[WebXRCanvasMirror::kMaxBlits];
+    for (float canvasAspect : kCanvasAspects)
+    {
+        // Each eye on its half of the canvas.
+        assert(WebXRCanvasMirror::GetBlits(kWebXRCanvasMirrorBothEyes, kSideBySideEyes, 2, kSideBySideAspect, canvasAspect, blits) == 2);
+        for (int eye = 0; eye < 2; ++eye)
+        {
+            assert(blits[eye].view == eye);
+            assert(IsNearRect(blits[eye].srcRect, kSideBySideEyes[eye]));
+            assert(IsNearRect(blits[eye].destRect, {eye * 0.5f, 0.0f, 0.5f, 1.0f}));
+        }
+
+        // From the slices of a texture array.
+        assert(WebXRCanvasMirror::GetBlits(kWebXRCanvasMirrorBothEyes, kArrayEyes, 2, 1.0f, canvasAspect, blits) == 2);
+        assert(blits[1].view == 1);
+        assert(IsNearRect(blits[1].srcRect, kFullRect));
+        assert(IsNearRect(blits[1].destRect, {0.5f, 0.0f, 0.5f, 1.0f}));
+
+        // A single view, like a handheld AR session, takes the whole canvas.
+        assert(WebXRCanvasMirror::GetBlits(kWebXRCanvasMirrorBothEyes, kArrayEyes, 1, 1.0f, canvasAspect, blits) == 1);
+        assert(IsNearRect(blits[0].destRect, kFullRect));
+    }
+}
+
+static void TestCropped()
+{
+    WebXRCanvasMirrorBlit blits[WebXRCanvasMirror::kMaxBlits];
+    // Centered crops of the square left eye with the aspect of each canvas.
+    const UnityXRRectf expected[] = {
+        {0.0f, 0.21875f, 0.5f, 0.5625f},
+        kSideBySideEyes[0],
+        {0.109375f, 0.0f, 0.28125f, 1.0f},
+    };
+    for (int i = 0; i < 3; ++i)
+    {
+        assert(WebXRCanvasMirror::GetBlits(kWebXRCanvasMirrorCropped, kSideBySideEyes, 2, kSideBySideAspect, kCanvasAspects[i], blits) == 1);
+        assert(blits[0].view == 0);
+        assert(IsNearRect(blits[0].srcRect, expected[i]));
+        assert(IsNearRect(blits[0].destRect, kFullRect));
+        // The crop has the canvas aspect, in pixels.
+        float srcAspect = blits[0].srcRect.width * kSideBySideAspect / blits[0].srcRect.height;
+        assert(IsNear(srcAspect, kCanvasAspects[i]));
+    }
+
+    // A viewport shrunk by dynamic resolution is cropped within itself.
+    const UnityXRRectf viewport = {0.0f, 0.0f, 0.4f, 0.8f};
+    assert(WebXRCanvasMirror::GetBlits(kWebXRCanvasMirrorCropped, &viewport, 1, kSideBySideAspect, 2.0f, blits) == 1);
+    assert(IsNearRect(blits[0].srcRect, {0.0f, 0.2f, 0.4f, 0.4f}));
+
+    // Unknown aspects leave the eye uncropped.
+    assert(IsNearRect(WebXRCanvasMirror::GetCroppedRect(kSideBySideEyes[0], kSideBySideAspect, 0.0f), kSideBySideEyes[0]));
+    assert(IsNearRect(WebXRCanvasMirror::GetCroppedRect(kSideBySideEyes[0], 0.0f, 2.0f), kSideBySideEyes[0]));
+}
+
+static void TestNothingToBlit()
+{
+    WebXRCanvasMirrorBlit blits[WebXRCanvasMirror::kMaxBlits];
+    assert(WebXRCanvasMirror::GetBlits(kWebXRCanvasMirrorNone, kSideBySideEyes, 2, kSideBySideAspect, 1.0f, blits) == 0);
+    assert(WebXRCanvasMirror::GetBlits(kWebXRCanvasMirrorLeftEye, kSideBySideEyes, 0, kSideBySideAspect, 1.0f, blits) == 0);
+    assert(WebXRCanvasMirror::GetBlits(42, kSideBySideEyes, 2, kSideBySideAspect, 1.0f, blits) == 0);
+}
+
+int main()
+{
+    RUN_TEST(TestLeftEye);
+    RUN_TEST(TestBothEyes);
+    RUN_TEST(TestCropped);
+    RUN_TEST(TestNothingToBlit);
+    return 0;
+}
@@ -0,0 +1,134 @@
+#include "WebXRFoveation.h"
+#include "WebXRTestUtils.h"
+
+struct ClipPoint
+{
+    float x, y, z, w;
+};
+
+static ClipPoint Project(const UnityXRMatrix4x4& projection, float x, float y, float z)
+{
+    const UnityXRVector4* c = projection.columns;
+    ClipPoint point;
+    point.x = c[0].x * x + c[1].x * y + c[2].x * z + c[3].x;
+    point.y = c[0].y * x + c[1].y * y + c[2].y * z + c[3].y;
+    point.z = c[0].z * x + c[1].z * y + c[2].z * z + c[3].z;
+    point.w = c[0].w * x + c[1].w * y + c[2].w * z + c[3].w;
+    return point;
+}
+
+// Left eye of a headset, its frustum wider on the temple side and below the view direction.
+static UnityXRMatrix4x4 MakeEyeProjection()
+{
+    return MakeProjection(-1.3f, 0.9f, -1.2f, 1.0f);
+}
+
+static void TestInnerRectOnViewDirection()
+{
+    // Symmetric projections get a centered rect.
+    UnityXRRectf rect = WebXRFoveation::GetInnerRect(MakeProjection(-1.0f, 1.0f, -1.0f, 1.0f), 0.5f);
+    assert(IsNearRect(rect, {0.25f, 0.25f, 0.5f, 0.5f}));
+
+    // Asymmetric ones have the rect centered where the view direction lands.
+    UnityXRMatrix4x4 eyeProjection = MakeEyeProjection();
+    rect = WebXRFoveation::GetInnerRect(eyeProjection, 0.5f);
+    ClipPoint center = Project(eyeProjection, 0.0f, 0.0f, -1.0f);
+    assert(IsNear(rect.x + 0.5f * rect.width, 0.5f * (center.x / center.w + 1.0f)));
+    assert(IsNear(rect.y + 0.5f * rect.height, 0.5f * (center.y / center.w + 1.0f)));
+    assert(rect.x > 0.25f && rect.y > 0.25f);
+}
+
+static void TestInnerRectInsideViewport()
+{
+    // View direction close to the right edge, the rect is pushed back inside.
+    UnityXRRectf rect = WebXRFoveation::GetInnerRect(MakeProjection(-2.0f, 0.2f, -1.0f, 1.0f), 0.5f);
+    assert(IsNearRect(rect, {0.5f, 0.25f, 0.5f, 0.5f}));
+
+    rect = WebXRFoveation::GetInnerRect(MakeEyeProjection(), 1.5f);
+    assert(IsNearRect(rect, {0.0f, 0.0f, 1.0f, 1.0f}));
+    rect = WebXRFoveation::GetInnerRect(MakeEyeProjection(), -1.0f);
+    assert(rect.width == 0.0f && rect.height == 0.0f);
+}
+
+// A point rendered by the inner pass lands where the eye pass puts it, once the inner viewport
+// is placed at the rect in the eye viewport.
+static void TestSubProjectionRoundTrip()
+{
+    UnityXRMatrix4x4 eyeProjection = MakeEyeProjection();
+    UnityXRRectf rect = WebXRFoveation::GetInnerRect(eyeProjection, 0.5f);
+    UnityXRMatrix4x4 subProjection = WebXRFoveation::GetSubProjection(eyeProjection, rect);
+
+    const float points[][3] = {
+        {0.0f, 0.0f, -1.0f},
+        {0.1f, -0.2f, -2.0f},
+        {-0.3f, 0.1f, -5.0f},
+        {2.0f, 1.5f, -3.0f},
+        {-0.01f, 0.02f, -0.15f},
+        {4.0f, -3.0f, -90.0f},
+    };
+    for (const auto& p : points)
+    {
+        ClipPoint eye = Project(eyeProjection, p[0], p[1], p[2]);
+        ClipPoint sub = Project(subProjection, p[0], p[1], p[2]);
+
+        // Eye viewport coordinates, then inner viewport coordinates through the rect.
+        float u = 0.5f * (eye.x / eye.w + 1.0f);
+        float v = 0.5f * (eye.y / eye.w + 1.0f);
+        float innerU = (u - rect.x) / rect.width;
+        float innerV = (v - rect.y) / rect.height;
+        assert(IsNear(0.5f * (sub.x / sub.w + 1.0f), innerU));
+        assert(IsNear(0.5f * (sub.y / sub.w + 1.0f), innerV));
+
+        // Same depth, so both passes share the depth range and clipping planes.
+        assert(IsNear(sub.z, eye.z));
+        assert(IsNear(sub.w, eye.w));
+    }
+
+    // The rect corners are the inner viewport corners.
+    for (int corner = 0; corner < 4; ++corner)
+    {
+        float u = rect.x + (corner & 1 ? rect.width : 0.0f);
+        float v = rect.y + (corner & 2 ? rect.height : 0.0f);
+        // Point on the ray through the corner, from the inverse of the off-axis eye projection.
+        const UnityXRVector4* c = eyeProjection.columns;
+        float x = ((2.0f * u - 1.0f) + c[2].x) / c[0].x;
+        float y = ((2.0f * v - 1.0f) + c[2].y) / c[1].y;
+        ClipPoint sub = Project(subProjection, x, y, -1.0f);
+        assert(IsNear(sub.x / sub.w, corner & 1 ? 1.0f : -1.0f));
+        assert(IsNear(sub.y / sub.w, corner & 2 ? 1.0f : -1.0f));
+    }
+}
+
+static void TestFullRectKeepsProjection()
+{
+    UnityXRMatrix4x4 eyeProjection = MakeEyeProjection();
+    UnityXRMatrix4x4 projection = WebXRFoveation::GetSubProjection(eyeProjection, {0.0f, 0.0f, 1.0f, 1.0f});
+    const float* a = &projection.columns[0].x;
+    const float* b = &eyeProjection.columns[0].x;
+    for (int i = 0; i < 16; ++i)
+    {
+        assert(IsNear(a[i], b[i]));
+    }
+}
+
+static void TestRectInside()
+{
+    UnityXRRectf outer = {0.5f, 0.0f, 0.5f, 0.8f};
+    UnityXRRectf rect = {0.2f, 0.25f, 0.5f, 0.5f};
+    UnityXRRectf inside = WebXRFoveation::GetRectInside(outer, rect);
+    assert(IsNearRect(inside, {0.6f, 0.2f, 0.25f, 0.4f}));
+    // Back to the rect, normalized to the outer rect.
+    UnityXRRectf back = {(inside.x - outer.x) / outer.width, (inside.y - outer.y) / outer.height,
+        inside.width / outer.width, inside.height / outer.height};
+    assert(IsNearRect(back, rect));
+}
+
+int main()
+{
+    RUN_TEST(TestInnerRectOnViewDirection);
+    RUN_TEST(TestInnerRectInsideViewport);
+    RUN_TEST(TestSubProjectionRoundTrip);
+    RUN_TEST(TestFullRectKeepsProjection);
+    RUN_TEST(TestRectInside);
+    return 0;
+}
@@ -0,0 +1,174 @@
+// Cost of GfxThread_PopulateNextFrameDesc when the cached frame descriptor is patched,
+// against a rebuild on every frame. The display provider is compiled as is, with the browser
+// functions and the Unity display interface stubbed.
+//   WebXRFrameDescBenchmark [frames]
+#include "WebXRDisplayProvider.cpp"
+#include "WebXRTestUtils.h"
+
+#include <cstdlib>
+
+static float s_ViewsData[WebXRFrameSnapshot::kViewsDataLength];
+static UnityXRRenderTextureId s_NextTextureId;
+static UnityXROcclusionMeshId s_NextMeshId;
+
+extern "C"
+{
+    float* WebXRGetViewsDataArray() { return s_ViewsData; }
+    int WebXRQuerySupportedFrameRates(float*, int) { return 0; }
+    float WebXRQueryFixedFoveation() { return 0.0f; }
+    void WebXRApplyFixedFoveation(float) {}
+    void WebXRApplyTargetFrameRate(float) {}
+    void WebXRBlitTextureToCanvas(uint32_t, int, int, int, int, int, float, float, float, float) {}
+    float WebXRGetCanvasAspect() { return 1.0f; }
+    void WebXRUpdateCompositionLayers() {}
+}
+
+static UnitySubsystemErrorCode UNITY_INTERFACE_API CreateTexture(UnitySubsystemHandle, const UnityXRRenderTextureDesc*, UnityXRRenderTextureId* textureId)
+{
+    *textureId = s_NextTextureId++;
+    return kUnitySubsystemErrorCodeSuccess;
+}
+
+static UnitySubsystemErrorCode UNITY_INTERFACE_API DestroyTexture(UnitySubsystemHandle, UnityXRRenderTextureId)
+{
+    return kUnitySubsystemErrorCodeSuccess;
+}
+
+static UnitySubsystemErrorCode UNITY_INTERFACE_API CreateOcclusionMesh(UnitySubsystemHandle, uint32_t, uint32_t, UnityXROcclusionMeshId* meshId)
+{
+    *meshId = s_NextMeshId++;
+    return kUnitySubsystemErrorCodeSuccess;
+}
+
+static UnitySubsystemErrorCode UNITY_INTERFACE_API DestroyOcclusionMesh(UnitySubsystemHandle, UnityXROcclusionMeshId)
+{
+    return kUnitySubsystemErrorCodeSuccess;
+}
+
+static UnitySubsystemErrorCode UNITY_INTERFACE_API SetOcclusionMesh(UnitySubsystemHandle, UnityXROcclusionMeshId, UnityXRVector2*, uint32_t, uint32_t*, uint32_t)
+{
+    return kUnitySubsystemErrorCodeSuccess;
+}
+
+// Two 1000x1000 views side by side, asymmetric projections 64 mm apart.
+static void InitViewsData()
+{
+    UnityXRMatrix4x4 left = MakeProjection(-1.2f, 1.0f, -1.1f, 1.0f);
+    UnityXRMatrix4x4 right = MakeProjection(-1.0f, 1.2f, -1.1f, 1.0f);
+    memcpy(s_ViewsData, &left, sizeof(left));
+    memcpy(s_ViewsData + 16, &right, sizeof(right));
+    s_ViewsData[40] = -0.032f;
+    s_ViewsData[43] = 0.032f;
+    const float viewports[] = {1000.0f, 1000.0f, 0.0f, 0.0f, 1000.0f, 1000.0f, 1000.0f, 0.0f};
+    memcpy(s_ViewsData + 46, viewports, sizeof(viewports));
+    s_ViewsData[54] = 2.0f;
+    s_ViewsData[56] = 2000.0f;
+    s_ViewsData[57] = 1000.0f;
+}
+
+// Head motion moves both eyes, their distance stays the same.
+static void NextXRFrame(int frame)
+{
+    s_ViewsData[41] = s_ViewsData[44] = 1.6f + 0.001f * (frame % 100);
+    s_ViewsData[59] = (float)frame;
+    s_ViewsData[60] = frame * 11.1f;
+}
+
+static bool IsSameRenderPasses(const UnityXRNextFrameDesc& a, const UnityXRNextFrameDesc& b)
+{
+    if (a.renderPassesCount != b.renderPassesCount)
+    {
+        return false;
+    }
+    for (int pass = 0; pass < a.renderPassesCount; ++pass)
+    {
+        const auto& passA = a.renderPasses[pass];
+        const auto& passB = b.renderPasses[pass];
+        if (passA.textureId != passB.textureId || passA.renderParamsCount != passB.renderParamsCount || passA.cullingPassIndex != passB.cullingPassIndex)
+        {
+            return false;
+        }
+        for (int i = 0; i < passA.renderParamsCount; ++i)
+        {
+            const auto& paramsA = passA.renderParams[i];
+            const auto& paramsB = passB.renderParams[i];
+            if (memcmp(&paramsA.deviceAnchorToEyePose, &paramsB.deviceAnchorToEyePose, sizeof(UnityXRPose)) != 0
+                || memcmp(&paramsA.projection.data.matrix, &paramsB.projection.data.matrix, sizeof(UnityXRMatrix4x4)) != 0
+                || memcmp(&paramsA.viewportRect, &paramsB.viewportRect, sizeof(UnityXRRectf)) != 0
+                || paramsA.occlusionMeshId != paramsB.occlusionMeshId
+                || (passA.renderParamsCount > 1 && paramsA.textureArraySlice != paramsB.textureArraySlice))
+            {
+                return false;
+            }
+        }
+    }
+    return memcmp(&a.cullingPasses[0].projection.data.matrix, &b.cullingPasses[0].projection.data.matrix, sizeof(UnityXRMatrix4x4)) == 0
+        && memcmp(&a.cullingPasses[0].deviceAnchorToCullingPose, &b.cullingPasses[0].deviceAnchorToCullingPose, sizeof(UnityXRPose)) == 0;
+}
+
+// Returns nanoseconds per frame. Rebuilt frames get a render viewport change every frame,
+// it dirties the layout without reallocating the textures.
+static double Run(bool singlePass, bool rebuild, int frames, UnityXRNextFrameDesc& lastFrame)
+{
+    IUnityXRDisplayInterface display = {};
+    display.CreateTexture = CreateTexture;
+    display.DestroyTexture = DestroyTexture;
+    display.CreateOcclusionMesh = CreateOcclusionMesh;
+    display.DestroyOcclusionMesh = DestroyOcclusionMesh;
+    display.SetOcclusionMesh = SetOcclusionMesh;
+    WebXRProviderContext ctx = {};
+    ctx.display = &display;
+    s_NextTextureId = 1;
+    s_NextMeshId = 1;
+
+    InitViewsData();
+    WebXRDisplayProvider provider(ctx, NULL);
+    provider.Initialize();
+    provider.Start();
+    UnityXRRenderingCapabilities renderingCaps = {};
+    provider.GfxThread_Start(renderingCaps);
+
+    UnityXRFrameSetupHints frameHints = {};
+    frameHints.appSetup.textureResolutionScale = 1.0f;
+    frameHints.appSetup.renderViewport = {0.0f, 0.0f, 1.0f, 1.0f};
+    frameHints.appSetup.singlePassRendering = singlePass;
+
+    // The first frame is skipped, the second one builds the cached descriptor.
+    static UnityXRNextFrameDesc nextFrame;
+    for (int frame = 0; frame < 2; ++frame)
+    {
+        NextXRFrame(frame);
+        provider.GfxThread_PopulateNextFrameDesc(frameHints, nextFrame);
+    }
+
+    frameHints.changedFlags = rebuild ? kUnityXRFrameSetupHintsChangedRenderViewport : kUnityXRFrameSetupHintsChangedNone;
+    auto start = std::chrono::steady_clock::now();
+    for (int frame = 2; frame < frames + 2; ++frame)
+    {
+        NextXRFrame(frame);
+        provider.GfxThread_PopulateNextFrameDesc(frameHints, nextFrame);
+        provider.GfxThread_SubmitCurrentFrame();
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    lastFrame = nextFrame;
+    provider.GfxThread_Stop();
+    provider.Shutdown();
+    return std::chrono::duration<double, std::nano>(end - start).count() / frames;
+}
+
+int main(int argc, char** argv)
+{
+    int frames = argc > 1 ? atoi(argv[1]) : 1000000;
+    for (int singlePass = 0; singlePass < 2; ++singlePass)
+    {
+        UnityXRNextFrameDesc rebuiltFrame;
+        UnityXRNextFrameDesc patchedFrame;
+        double rebuilt = Run(singlePass != 0, true, frames, rebuiltFrame);
+        double patched = Run(singlePass != 0, false, frames, patchedFrame);
+        // The cache must not change what Unity renders.
+        assert(IsSameRenderPasses(rebuiltFrame, patchedFrame));
+        printf("%-11s rebuilt %7.1f ns/frame, patched %7.1f ns/frame\n", singlePass ? "single-pass" : "multi-pass", rebuilt, patched);
+    }
+    return 0;
+}
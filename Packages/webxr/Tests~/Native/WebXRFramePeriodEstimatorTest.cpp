@@ -0,0 +1,67 @@
+#include "WebXRFramePeriodEstimator.h"
+#include "WebXRTestUtils.h"
+
+static const int kWindow = WebXRFramePeriodEstimator::kWindowFrames;
+
+static void AddIntervals(WebXRFramePeriodEstimator& estimator, int frames, float interval)
+{
+    for (int i = 0; i < frames; ++i)
+    {
+        estimator.AddInterval(interval);
+    }
+}
+
+static void TestShortestInterval()
+{
+    WebXRFramePeriodEstimator estimator;
+    assert(estimator.GetPeriod() == 0.0f);
+    // Ignored, like the first frame of a session that has no previous frame.
+    estimator.AddInterval(0.0f);
+    assert(estimator.GetPeriod() == 0.0f);
+
+    // Late frames at 90 Hz never lengthen the period.
+    estimator.AddInterval(11.1f);
+    estimator.AddInterval(22.2f);
+    estimator.AddInterval(33.3f);
+    assert(IsNear(estimator.GetPeriod(), 11.1f));
+    // Jitter shortens it right away.
+    estimator.AddInterval(11.0f);
+    assert(IsNear(estimator.GetPeriod(), 11.0f));
+}
+
+static void TestRefreshRateChanges()
+{
+    WebXRFramePeriodEstimator estimator;
+    AddIntervals(estimator, kWindow, 11.1f);
+    assert(IsNear(estimator.GetPeriod(), 11.1f));
+
+    // Down to 72 Hz: picked up at the end of the first full window at the new rate.
+    AddIntervals(estimator, kWindow - 1, 13.9f);
+    assert(IsNear(estimator.GetPeriod(), 11.1f));
+    estimator.AddInterval(13.9f);
+    assert(IsNear(estimator.GetPeriod(), 13.9f));
+
+    // Up to 120 Hz: picked up on the first frame.
+    estimator.AddInterval(8.3f);
+    assert(IsNear(estimator.GetPeriod(), 8.3f));
+}
+
+static void TestReset()
+{
+    WebXRFramePeriodEstimator estimator;
+    AddIntervals(estimator, kWindow / 2, 8.3f);
+    estimator.Reset();
+    assert(estimator.GetPeriod() == 0.0f);
+
+    // The window restarts too, the intervals from before the reset never come back at its end.
+    AddIntervals(estimator, kWindow - kWindow / 2, 11.1f);
+    assert(IsNear(estimator.GetPeriod(), 11.1f));
+}
+
+int main()
+{
+    RUN_TEST(TestShortestInterval);
+    RUN_TEST(TestRefreshRateChanges);
+    RUN_TEST(TestReset);
+    return 0;
+}
@@ -0,0 +1,271 @@
+#include "WebXRGpuTimer.h"
+#include "WebXRTestUtils.h"
+
+#include <map>
+
+// Fake GPU: each query finishes a set number of frames after it ends, its elapsed time set by the test.
+class MockGpuTimerBackend : public WebXRGpuTimerBackend
+{
+public:
+    struct Query
+    {
+        int readyFrame = -1;
+        uint64_t elapsed = 0;
+    };
+
+    bool IsAvailable() override { return available; }
+
+    uint32_t CreateQuery() override
+    {
+        uint32_t query = nextQuery++;
+        queries[query] = Query();
+        return query;
+    }
+
+    void DeleteQuery(uint32_t query) override
+    {
+        assert(queries.count(query) == 1);
+        queries.erase(query);
+    }
+
+    void BeginQuery(uint32_t query) override
+    {
+        assert(activeQuery == 0);
+        assert(queries.count(query) == 1);
+        activeQuery = query;
+        beginCount++;
+    }
+
+    void EndQuery() override
+    {
+        assert(activeQuery != 0);
+        queries[activeQuery].readyFrame = frame + latency;
+        queries[activeQuery].elapsed = nextElapsed;
+        activeQuery = 0;
+    }
+
+    bool IsResultAvailable(uint32_t query) override
+    {
+        return queries[query].readyFrame >= 0 && frame >= queries[query].readyFrame;
+    }
+
+    uint64_t GetResult(uint32_t query) override
+    {
+        assert(IsResultAvailable(query));
+        return queries[query].elapsed;
+    }
+
+    bool IsDisjoint() override
+    {
+        bool wasDisjoint = disjoint;
+        disjoint = false;
+        return wasDisjoint;
+    }
+
+    bool available = true;
+    bool disjoint = false;
+    int frame = 0;
+    // Frames between the end of a query and its result.
+    int latency = 2;
+    uint64_t nextElapsed = 0;
+    uint32_t activeQuery = 0;
+    int beginCount = 0;
+    uint32_t nextQuery = 1;
+    std::map<uint32_t, Query> queries;
+};
+
+// One app frame: results polled at the frame setup, the frame measured until its submit.
+static bool RunFrame(WebXRGpuTimer& timer, MockGpuTimerBackend& backend, double milliseconds)
+{
+    bool hasResult = timer.Poll();
+    backend.nextElapsed = (uint64_t)(milliseconds * 1e6);
+    timer.BeginFrame();
+    timer.EndFrame();
+    backend.frame++;
+    return hasResult;
+}
+
+static void TestResultsArriveLate()
+{
+    MockGpuTimerBackend backend;
+    WebXRGpuTimer timer;
+    timer.Initialize(&backend);
+    assert(timer.IsEnabled());
+
+    // Frame N reads the result of frame N - 2, the GPU latency.
+    assert(!RunFrame(timer, backend, 4.0));
+    assert(!RunFrame(timer, backend, 5.0));
+    for (int frame = 2; frame < 20; ++frame)
+    {
+        assert(RunFrame(timer, backend, 4.0 + frame));
+        assert(IsNear(timer.GetFrameTime(), (4.0f + frame - 2) * 0.001f));
+    }
+    // One query per frame in flight, reused in turn.
+    assert(backend.queries.size() == WebXRGpuTimer::kFramesInFlight);
+    // Without pass events the whole frame is pass 0.
+    assert(timer.GetPassesCount() == 1);
+    assert(timer.GetPassTime(0) == timer.GetFrameTime());
+
+    timer.Shutdown();
+    assert(backend.queries.empty());
+    assert(!timer.IsEnabled());
+}
+
+// One app frame of passes rendered one after the other, with a pass event before each of them.
+static bool RunPassesFrame(WebXRGpuTimer& timer, MockGpuTimerBackend& backend, const double* milliseconds, int passesCount)
+{
+    bool hasResult = timer.Poll();
+    timer.BeginFrame();
+    // The event of the first pass comes after the frame setup, already measured as pass 0.
+    timer.BeginPass(0);
+    for (int pass = 0; pass < passesCount; ++pass)
+    {
+        // Elapsed time of the query ended by the next event.
+        backend.nextElapsed = (uint64_t)(milliseconds[pass] * 1e6);
+        if (pass + 1 < passesCount)
+        {
+            timer.BeginPass(pass + 1);
+        }
+    }
+    timer.EndFrame();
+    backend.frame++;
+    return hasResult;
+}
+
+static void TestPassBreakdown()
+{
+    MockGpuTimerBackend backend;
+    WebXRGpuTimer timer;
+    timer.Initialize(&backend);
+
+    const double passTimes[] = {2.0, 3.0, 0.5};
+    for (int frame = 0; frame < WebXRGpuTimer::kFramesInFlight; ++frame)
+    {
+        RunPassesFrame(timer, backend, passTimes, 3);
+    }
+    assert(timer.GetPassesCount() == 3);
+    assert(IsNear(timer.GetPassTime(0), 0.002f));
+    assert(IsNear(timer.GetPassTime(1), 0.003f));
+    assert(IsNear(timer.GetPassTime(2), 0.0005f));
+    assert(IsNear(timer.GetFrameTime(), 0.0055f));
+    assert(timer.GetPassTime(3) == 0.0f);
+    // Each pass of each frame in flight has its own query.
+    assert(backend.queries.size() == 3 * WebXRGpuTimer::kFramesInFlight);
+
+    // Out of order or repeated events don't restart a pass, and passes past the last one are ignored.
+    timer.BeginFrame();
+    timer.BeginPass(2);
+    int begins = backend.beginCount;
+    timer.BeginPass(1);
+    timer.BeginPass(2);
+    timer.BeginPass(WebXRGpuTimer::kMaxPasses);
+    assert(backend.beginCount == begins);
+    timer.EndFrame();
+    backend.frame += backend.latency;
+    while (timer.Poll())
+    {
+    }
+    // The skipped pass 1 has no time of its own, it's counted in pass 0.
+    assert(timer.GetPassesCount() == 3);
+    assert(timer.GetPassTime(1) == 0.0f);
+    assert(IsNear(timer.GetFrameTime(), timer.GetPassTime(0) + timer.GetPassTime(2)));
+
+    timer.Shutdown();
+    assert(backend.queries.empty());
+}
+
+static void TestFramesInFlightNeverStall()
+{
+    MockGpuTimerBackend backend;
+    // Slower than the frames in flight can cover.
+    backend.latency = WebXRGpuTimer::kFramesInFlight + 2;
+    WebXRGpuTimer timer;
+    timer.Initialize(&backend);
+
+    int results = 0;
+    for (int frame = 0; frame < 40; ++frame)
+    {
+        // Results are only read once available, the mock asserts it.
+        results += RunFrame(timer, backend, 1.0) ? 1 : 0;
+        // Never more queries than frames in flight, frames are skipped instead of waiting for a free one.
+        assert(backend.queries.size() <= WebXRGpuTimer::kFramesInFlight);
+    }
+    // The first four frames are measured, the next two skipped until the first result frees its slot.
+    assert(backend.beginCount < 40);
+    assert(backend.beginCount >= 40 * WebXRGpuTimer::kFramesInFlight / backend.latency);
+    assert(results > 0);
+    assert(IsNear(timer.GetFrameTime(), 0.001f));
+    timer.Shutdown();
+}
+
+static void TestDisjointDropsPendingFrames()
+{
+    MockGpuTimerBackend backend;
+    WebXRGpuTimer timer;
+    timer.Initialize(&backend);
+    for (int frame = 0; frame < 4; ++frame)
+    {
+        RunFrame(timer, backend, 3.0);
+    }
+    assert(IsNear(timer.GetFrameTime(), 0.003f));
+
+    // The pending frames ran across the disjoint event, their times are thrown away.
+    RunFrame(timer, backend, 100.0);
+    RunFrame(timer, backend, 100.0);
+    backend.disjoint = true;
+    assert(!RunFrame(timer, backend, 6.0));
+    assert(IsNear(timer.GetFrameTime(), 0.003f));
+    // Frames started after it are measured again.
+    assert(!RunFrame(timer, backend, 6.0));
+    assert(RunFrame(timer, backend, 6.0));
+    assert(IsNear(timer.GetFrameTime(), 0.006f));
+    timer.Shutdown();
+}
+
+static void TestUnavailable()
+{
+    MockGpuTimerBackend backend;
+    backend.available = false;
+    WebXRGpuTimer timer;
+    timer.Initialize(&backend);
+    assert(!timer.IsEnabled());
+    for (int frame = 0; frame < 10; ++frame)
+    {
+        assert(!RunFrame(timer, backend, 3.0));
+    }
+    assert(backend.queries.empty());
+    assert(timer.GetFrameTime() == 0.0f);
+    timer.Shutdown();
+
+    // No backend at all, like a browser without the timer query extension.
+    timer.Initialize(NULL);
+    assert(!timer.IsEnabled());
+    timer.BeginFrame();
+    timer.BeginPass(1);
+    timer.EndFrame();
+    assert(!timer.Poll());
+    timer.Shutdown();
+}
+
+static void TestShutdownDuringFrame()
+{
+    MockGpuTimerBackend backend;
+    WebXRGpuTimer timer;
+    timer.Initialize(&backend);
+    timer.BeginFrame();
+    timer.BeginPass(1);
+    timer.Shutdown();
+    assert(backend.activeQuery == 0);
+    assert(backend.queries.empty());
+}
+
+int main()
+{
+    RUN_TEST(TestResultsArriveLate);
+    RUN_TEST(TestPassBreakdown);
+    RUN_TEST(TestFramesInFlightNeverStall);
+    RUN_TEST(TestDisjointDropsPendingFrames);
+    RUN_TEST(TestUnavailable);
+    RUN_TEST(TestShutdownDuringFrame);
+    return 0;
+}
@@ -0,0 +1,145 @@
+#include "WebXRHapticQueue.h"
+#include "WebXRTestUtils.h"
+
+static void TestSinglePulse()
+{
+    WebXRHapticQueue queue;
+    WebXRHapticPulse pulse;
+    assert(queue.IsEmpty());
+    assert(!queue.Flush(0.0, pulse));
+
+    // Amplitudes are clamped to 1, empty pulses are ignored.
+    queue.Pulse(0.0f, 100.0f);
+    queue.Pulse(0.5f, 0.0f);
+    assert(queue.IsEmpty());
+    queue.Pulse(2.0f, 100.0f);
+    assert(queue.Flush(1000.0, pulse));
+    assert(pulse.amplitude == 1.0f && IsNear(pulse.duration, 100.0f));
+    assert(queue.IsEmpty());
+}
+
+static void TestCoveredPulseDropped()
+{
+    WebXRHapticQueue queue;
+    WebXRHapticPulse pulse;
+    queue.Pulse(0.8f, 200.0f);
+    assert(queue.Flush(1000.0, pulse));
+
+    // Weaker and ending before the playing pulse: nothing to send, the playing one isn't restarted.
+    queue.Pulse(0.5f, 100.0f);
+    assert(!queue.Flush(1050.0, pulse));
+    // Queued in the same frame, the covered one doesn't change the merged pulse either.
+    queue.Pulse(0.8f, 200.0f);
+    queue.Pulse(0.3f, 50.0f);
+    assert(queue.Flush(1100.0, pulse));
+    assert(pulse.amplitude == 0.8f && IsNear(pulse.duration, 200.0f));
+}
+
+static void TestStrongestUntilLatestEnd()
+{
+    WebXRHapticQueue queue;
+    WebXRHapticPulse pulse;
+    // A strong short pulse and a weak long one merge into the strong one until the end of the long one.
+    queue.Pulse(0.9f, 50.0f);
+    queue.Pulse(0.2f, 300.0f);
+    assert(queue.Flush(1000.0, pulse));
+    assert(pulse.amplitude == 0.9f && IsNear(pulse.duration, 300.0f));
+
+    // A later stronger pulse keeps the end of the one playing, and raises the amplitude.
+    queue.Pulse(1.0f, 100.0f);
+    assert(queue.Flush(1100.0, pulse));
+    assert(pulse.amplitude == 1.0f && IsNear(pulse.duration, 200.0f));
+
+    // Once the playing pulse ended, a weak pulse plays at its own amplitude.
+    queue.Pulse(0.2f, 100.0f);
+    assert(queue.Flush(1400.0, pulse));
+    assert(pulse.amplitude == 0.2f && IsNear(pulse.duration, 100.0f));
+}
+
+static void TestStopDiscardsEarlierCommands()
+{
+    WebXRHapticQueue queue;
+    WebXRHapticPulse pulse;
+    queue.Pulse(0.5f, 500.0f);
+    assert(queue.Flush(1000.0, pulse));
+
+    // The pulses queued before the stop never play, the stop cuts the playing pulse.
+    queue.Pulse(1.0f, 1000.0f);
+    queue.Stop();
+    assert(queue.Flush(1100.0, pulse));
+    assert(pulse.amplitude == 0.0f && pulse.duration == 0.0f);
+
+    // Pulses after a stop in the same frame play from nothing.
+    queue.Pulse(1.0f, 1000.0f);
+    queue.Stop();
+    queue.Pulse(0.3f, 100.0f);
+    assert(queue.Flush(1200.0, pulse));
+    assert(pulse.amplitude == 0.3f && IsNear(pulse.duration, 100.0f));
+}
+
+static void TestStopWithNothingPlaying()
+{
+    WebXRHapticQueue queue;
+    WebXRHapticPulse pulse;
+    queue.Stop();
+    assert(!queue.IsEmpty());
+    assert(!queue.Flush(1000.0, pulse));
+    assert(queue.IsEmpty());
+
+    // Nor after the last pulse ended.
+    queue.Pulse(0.5f, 100.0f);
+    assert(queue.Flush(1000.0, pulse));
+    queue.Stop();
+    assert(!queue.Flush(1200.0, pulse));
+}
+
+static void TestFullQueueMergesPulses()
+{
+    WebXRHapticQueue queue;
+    WebXRHapticPulse pulse;
+    for (int i = 0; i < WebXRHapticQueue::kCapacity; ++i)
+    {
+        queue.Pulse(0.1f, 10.0f);
+    }
+    // No room left, merged into the last command instead of dropped.
+    queue.Pulse(0.7f, 20.0f);
+    queue.Pulse(0.4f, 400.0f);
+    assert(queue.Flush(1000.0, pulse));
+    assert(pulse.amplitude == 0.7f && IsNear(pulse.duration, 400.0f));
+
+    // A stop still fits in a full queue.
+    for (int i = 0; i < WebXRHapticQueue::kCapacity; ++i)
+    {
+        queue.Pulse(0.1f, 10.0f);
+    }
+    queue.Stop();
+    assert(queue.Flush(1100.0, pulse));
+    assert(pulse.amplitude == 0.0f);
+}
+
+static void TestClear()
+{
+    WebXRHapticQueue queue;
+    WebXRHapticPulse pulse;
+    queue.Pulse(0.8f, 500.0f);
+    assert(queue.Flush(1000.0, pulse));
+    queue.Pulse(0.5f, 100.0f);
+    queue.Clear();
+    assert(queue.IsEmpty());
+    // The playing pulse is forgotten too, like on a new session.
+    queue.Pulse(0.5f, 100.0f);
+    assert(queue.Flush(1100.0, pulse));
+    assert(pulse.amplitude == 0.5f && IsNear(pulse.duration, 100.0f));
+}
+
+int main()
+{
+    RUN_TEST(TestSinglePulse);
+    RUN_TEST(TestCoveredPulseDropped);
+    RUN_TEST(TestStrongestUntilLatestEnd);
+    RUN_TEST(TestStopDiscardsEarlierCommands);
+    RUN_TEST(TestStopWithNothingPlaying);
+    RUN_TEST(TestFullQueueMergesPulses);
+    RUN_TEST(TestClear);
+    return 0;
+}
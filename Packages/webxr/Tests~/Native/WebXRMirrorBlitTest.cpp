@@ -0,0 +1,133 @@
+#include "WebXRMirrorBlit.h"
+#include "WebXRSinglePass.h"
+#include "WebXRTestUtils.h"
+
+static const float kViewports[] = {
+    1000.0f, 1000.0f, 0.0f, 0.0f,
+    1000.0f, 1000.0f, 1000.0f, 0.0f
+};
+static const UnityXRRectf kFullViewport = {0.0f, 0.0f, 1.0f, 1.0f};
+// Dynamic resolution scale of the frames.
+static const float kScale = 0.5f;
+
+static WebXRViewLayout MakeLayout(int viewsCount)
+{
+    WebXRViewLayout layout;
+    // Padded framebuffer, the views don't cover its top.
+    layout.Update(kViewports, viewsCount, 1000.0f * viewsCount, 1250.0f);
+    return layout;
+}
+
+// Multi-pass frame of the governor scale, one side by side texture.
+static UnityXRNextFrameDesc MakeMultiPassFrame(const WebXRViewLayout& layout)
+{
+    UnityXRNextFrameDesc frame = {};
+    frame.renderPassesCount = layout.GetViewsCount();
+    for (int pass = 0; pass < frame.renderPassesCount; ++pass)
+    {
+        frame.renderPasses[pass].textureId = 7;
+        frame.renderPasses[pass].renderParamsCount = 1;
+        frame.renderPasses[pass].renderParams[0].viewportRect =
+            WebXRViewLayout::GetRenderRect(layout.GetViewRect(pass, kWebXRTextureLayoutSideBySide), kFullViewport, kScale);
+    }
+    return frame;
+}
+
+static void TestScaledViewsFillTheFramebufferViews()
+{
+    WebXRViewLayout layout = MakeLayout(2);
+    UnityXRNextFrameDesc frame = MakeMultiPassFrame(layout);
+
+    UnityXRMirrorViewBlitDesc blitDesc = {};
+    WebXRMirrorBlit::GetBlitDesc(frame, kUnityXRMirrorBlitSideBySide, layout, NULL, blitDesc);
+    assert(blitDesc.blitParamsCount == 2);
+    for (int eye = 0; eye < 2; ++eye)
+    {
+        const auto& blitParams = blitDesc.blitParams[eye];
+        // Only the rendered quarter of each view is sampled...
+        assert(IsNearRect(blitParams.srcRect, {eye * 0.5f, 0.0f, 0.25f, 0.5f}));
+        // ...and stretched over the whole view, not shown shrunk in its corner.
+        assert(IsNearRect(blitParams.destRect, layout.GetFramebufferRect(eye)));
+        assert(IsNearRect(blitParams.destRect, {eye * 0.5f, 0.0f, 0.5f, 0.8f}));
+        assert(blitParams.srcTexId == 7);
+        assert(blitParams.srcTexArraySlice == 0);
+    }
+}
+
+static void TestSingleEyeModes()
+{
+    WebXRViewLayout layout = MakeLayout(2);
+    UnityXRNextFrameDesc frame = MakeMultiPassFrame(layout);
+
+    UnityXRMirrorViewBlitDesc blitDesc = {};
+    WebXRMirrorBlit::GetBlitDesc(frame, kUnityXRMirrorBlitRightEye, layout, NULL, blitDesc);
+    assert(blitDesc.blitParamsCount == 1);
+    assert(IsNearRect(blitDesc.blitParams[0].srcRect, frame.renderPasses[1].renderParams[0].viewportRect));
+    assert(IsNearRect(blitDesc.blitParams[0].destRect, kFullViewport));
+
+    // Mono sessions mirror their only view in both modes.
+    WebXRViewLayout monoLayout = MakeLayout(1);
+    UnityXRNextFrameDesc monoFrame = MakeMultiPassFrame(monoLayout);
+    WebXRMirrorBlit::GetBlitDesc(monoFrame, kUnityXRMirrorBlitRightEye, monoLayout, NULL, blitDesc);
+    assert(blitDesc.blitParamsCount == 1);
+    assert(IsNearRect(blitDesc.blitParams[0].srcRect, {0.0f, 0.0f, kScale, kScale}));
+
+    WebXRMirrorBlit::GetBlitDesc(frame, kUnityXRMirrorBlitNone, layout, NULL, blitDesc);
+    assert(blitDesc.blitParamsCount == 0);
+}
+
+static void TestSinglePassTextureArray()
+{
+    WebXRViewLayout layout = MakeLayout(2);
+    WebXRSinglePassEye eyes[WebXRSinglePass::kEyesCount] = {};
+    UnityXRNextFrameDesc frame = {};
+    frame.renderPassesCount = 1;
+    WebXRSinglePass::Fill(layout, kWebXRTextureLayoutTextureArray, 9, eyes, kFullViewport, kScale, frame.renderPasses[0]);
+
+    UnityXRMirrorViewBlitDesc blitDesc = {};
+    WebXRMirrorBlit::GetBlitDesc(frame, kUnityXRMirrorBlitSideBySide, layout, NULL, blitDesc);
+    assert(blitDesc.blitParamsCount == 2);
+    for (int eye = 0; eye < 2; ++eye)
+    {
+        assert(blitDesc.blitParams[eye].srcTexId == 9);
+        assert(blitDesc.blitParams[eye].srcTexArraySlice == eye);
+        assert(IsNearRect(blitDesc.blitParams[eye].srcRect, {0.0f, 0.0f, kScale, kScale}));
+        assert(IsNearRect(blitDesc.blitParams[eye].destRect, layout.GetFramebufferRect(eye)));
+    }
+}
+
+static void TestFoveatedInnerViewsOverOuterViews()
+{
+    WebXRViewLayout layout = MakeLayout(2);
+    UnityXRNextFrameDesc frame = {};
+    frame.renderPassesCount = 4;
+    for (int pass = 0; pass < 4; ++pass)
+    {
+        frame.renderPasses[pass].textureId = pass < 2 ? 1 : 2;
+        frame.renderPasses[pass].renderParamsCount = 1;
+        frame.renderPasses[pass].renderParams[0].viewportRect = layout.GetViewRect(pass % 2, kWebXRTextureLayoutSideBySide);
+    }
+    const UnityXRRectf innerRects[] = {{0.3f, 0.25f, 0.5f, 0.5f}, {0.2f, 0.25f, 0.5f, 0.5f}};
+
+    UnityXRMirrorViewBlitDesc blitDesc = {};
+    WebXRMirrorBlit::GetBlitDesc(frame, kUnityXRMirrorBlitSideBySide, layout, innerRects, blitDesc);
+    assert(blitDesc.blitParamsCount == 4);
+    // Outer views first, so the inner ones are drawn over them.
+    assert(blitDesc.blitParams[0].srcTexId == 1 && blitDesc.blitParams[1].srcTexId == 1);
+    assert(blitDesc.blitParams[2].srcTexId == 2 && blitDesc.blitParams[3].srcTexId == 2);
+    assert(IsNearRect(blitDesc.blitParams[2].destRect, {0.3f * 0.5f, 0.25f * 0.8f, 0.25f, 0.4f}));
+    assert(IsNearRect(blitDesc.blitParams[3].destRect, {0.5f + 0.2f * 0.5f, 0.25f * 0.8f, 0.25f, 0.4f}));
+
+    WebXRMirrorBlit::GetBlitDesc(frame, kUnityXRMirrorBlitLeftEye, layout, innerRects, blitDesc);
+    assert(blitDesc.blitParamsCount == 2);
+    assert(IsNearRect(blitDesc.blitParams[1].destRect, innerRects[0]));
+}
+
+int main()
+{
+    RUN_TEST(TestScaledViewsFillTheFramebufferViews);
+    RUN_TEST(TestSingleEyeModes);
+    RUN_TEST(TestSinglePassTextureArray);
+    RUN_TEST(TestFoveatedInnerViewsOverOuterViews);
+    return 0;
+}
@@ -0,0 +1,111 @@
+#include "WebXROcclusionMesh.h"
+#include "WebXRTestUtils.h"
+
+// Twice the signed area, positive for counter-clockwise triangles.
+static float SignedArea(const UnityXRVector2& a, const UnityXRVector2& b, const UnityXRVector2& c)
+{
+    return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+}
+
+static bool IsInsideTriangle(const UnityXRVector2& point, const UnityXRVector2& a, const UnityXRVector2& b, const UnityXRVector2& c)
+{
+    float ab = SignedArea(a, b, point);
+    float bc = SignedArea(b, c, point);
+    float ca = SignedArea(c, a, point);
+    return (ab >= 0.0f && bc >= 0.0f && ca >= 0.0f) || (ab <= 0.0f && bc <= 0.0f && ca <= 0.0f);
+}
+
+static bool IsCovered(const WebXROcclusionMesh& mesh, const UnityXRVector2& point)
+{
+    for (uint32_t i = 0; i < WebXROcclusionMesh::kNumIndices; i += 3)
+    {
+        const UnityXRVector2& a = mesh.vertices[mesh.indices[i]];
+        const UnityXRVector2& b = mesh.vertices[mesh.indices[i + 1]];
+        const UnityXRVector2& c = mesh.vertices[mesh.indices[i + 2]];
+        if (fabsf(SignedArea(a, b, c)) > 1e-7f && IsInsideTriangle(point, a, b, c))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Inside the polygon of the inner ring, a fan around the optical axis.
+static bool IsVisible(const WebXROcclusionMesh& mesh, const UnityXRVector2& center, const UnityXRVector2& point)
+{
+    for (int i = 0; i < WebXROcclusionMesh::kSegments; ++i)
+    {
+        const UnityXRVector2& a = mesh.vertices[i * 2];
+        const UnityXRVector2& b = mesh.vertices[((i + 1) % WebXROcclusionMesh::kSegments) * 2];
+        if (IsInsideTriangle(point, center, a, b))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void CheckMesh(const UnityXRMatrix4x4& projection)
+{
+    WebXROcclusionMesh mesh;
+    mesh.Build(projection);
+    UnityXRVector2 center = {0.5f * (1.0f - projection.columns[2].x), 0.5f * (1.0f - projection.columns[2].y)};
+
+    // Bounds: every vertex stays inside the viewport, nothing relies on clipping.
+    for (uint32_t i = 0; i < WebXROcclusionMesh::kNumVertices; ++i)
+    {
+        assert(mesh.vertices[i].x >= 0.0f && mesh.vertices[i].x <= 1.0f);
+        assert(mesh.vertices[i].y >= 0.0f && mesh.vertices[i].y <= 1.0f);
+    }
+    for (uint32_t i = 0; i < WebXROcclusionMesh::kNumIndices; ++i)
+    {
+        assert(mesh.indices[i] < WebXROcclusionMesh::kNumVertices);
+    }
+
+    // Winding: every triangle that isn't degenerate is counter-clockwise, none is folded over.
+    for (uint32_t i = 0; i < WebXROcclusionMesh::kNumIndices; i += 3)
+    {
+        float area = SignedArea(mesh.vertices[mesh.indices[i]], mesh.vertices[mesh.indices[i + 1]], mesh.vertices[mesh.indices[i + 2]]);
+        assert(area >= -1e-7f);
+    }
+
+    // The corners are hidden, the optical axis is visible.
+    const UnityXRVector2 corners[] = {{0.0f, 0.0f}, {1.0f, 0.0f}, {0.0f, 1.0f}, {1.0f, 1.0f}};
+    for (const UnityXRVector2& corner : corners)
+    {
+        assert(IsCovered(mesh, corner));
+    }
+    assert(!IsCovered(mesh, center));
+
+    // Every point of the viewport is either covered by the mesh or inside the inner ring.
+    const int kSamples = 41;
+    for (int y = 0; y < kSamples; ++y)
+    {
+        for (int x = 0; x < kSamples; ++x)
+        {
+            UnityXRVector2 point = {(x + 0.37f) / kSamples, (y + 0.61f) / kSamples};
+            assert(IsCovered(mesh, point) || IsVisible(mesh, center, point));
+        }
+    }
+}
+
+static void TestSymmetricProjection()
+{
+    CheckMesh(MakeProjection(-1.0f, 1.0f, -1.0f, 1.0f));
+}
+
+static void TestAsymmetricProjections()
+{
+    // Outer halves wider than the inner ones, like most headset eyes.
+    CheckMesh(MakeProjection(-1.4f, 1.0f, -1.2f, 1.0f));
+    CheckMesh(MakeProjection(-1.0f, 1.4f, -1.2f, 1.0f));
+    // Strongly off-axis, the optical axis close to a viewport edge.
+    CheckMesh(MakeProjection(-3.0f, 0.4f, -0.5f, 2.0f));
+}
+
+int main()
+{
+    RUN_TEST(TestSymmetricProjection);
+    RUN_TEST(TestAsymmetricProjections);
+    return 0;
+}
@@ -0,0 +1,182 @@
+#include "WebXRPerformancePolicy.h"
+#include "WebXRResolutionGovernor.h"
+#include "WebXRTestUtils.h"
+
+#include <vector>
+
+static const float kFrameRates[] = {60.0f, 72.0f, 90.0f};
+
+enum ChangeKind
+{
+    kResolutionChange,
+    kFoveationChange,
+    kFrameRateChange,
+};
+
+struct Change
+{
+    int frame;
+    ChangeKind kind;
+    float value;
+};
+
+// The governor and the policy fed like WebXR Display does, records every change of either.
+struct PerformanceTrace
+{
+    WebXRResolutionGovernor governor;
+    WebXRPerformancePolicy policy;
+    std::vector<Change> changes;
+    int frame = 0;
+
+    PerformanceTrace(float foveationLevel = 0.0f)
+    {
+        governor.Configure(true, 0.5f, 1.0f);
+        policy.Configure(true, kFrameRates, 3, foveationLevel);
+    }
+
+    // work in milliseconds, the frames come at the target frame rate.
+    void Play(int frames, float work)
+    {
+        for (int i = 0; i < frames; ++i, ++frame)
+        {
+            float frameRate = policy.GetTargetFrameRate() > 0.0f ? policy.GetTargetFrameRate() : 90.0f;
+            float period = 1000.0f / frameRate;
+            float foveationLevel = policy.GetFoveationLevel();
+            if (governor.AddFrame(period, work))
+            {
+                changes.push_back({frame, kResolutionChange, governor.GetScale()});
+            }
+            if (policy.AddFrame(period, work, period, 90.0f, !governor.IsAtMinScale()))
+            {
+                if (policy.GetFoveationLevel() != foveationLevel)
+                {
+                    changes.push_back({frame, kFoveationChange, policy.GetFoveationLevel()});
+                }
+                if (policy.GetTargetFrameRate() != frameRate)
+                {
+                    changes.push_back({frame, kFrameRateChange, policy.GetTargetFrameRate()});
+                }
+            }
+        }
+    }
+
+    std::vector<Change> Kinds(ChangeKind kind) const
+    {
+        std::vector<Change> result;
+        for (const Change& change : changes)
+        {
+            if (change.kind == kind)
+            {
+                result.push_back(change);
+            }
+        }
+        return result;
+    }
+};
+
+static void TestEscalationOrder()
+{
+    PerformanceTrace trace;
+    // 10.5 ms of work is over 90% of the 90 Hz period, fits in the 72 Hz one.
+    trace.Play(2000, 10.5f);
+
+    // Resolution down to the minimum first...
+    std::vector<Change> resolution = trace.Kinds(kResolutionChange);
+    assert(resolution.size() == 5);
+    assert(IsNear(resolution.back().value, 0.5f));
+    // ...then foveation in steps up to the maximum...
+    std::vector<Change> foveation = trace.Kinds(kFoveationChange);
+    assert(foveation.size() == 4);
+    assert(foveation.front().frame > resolution.back().frame);
+    assert(IsNear(foveation.front().value, 0.25f));
+    assert(IsNear(foveation.back().value, 1.0f));
+    // ...and the frame rate last, one step down is enough.
+    std::vector<Change> frameRate = trace.Kinds(kFrameRateChange);
+    assert(frameRate.size() == 1);
+    assert(frameRate[0].frame > foveation.back().frame);
+    assert(frameRate[0].value == 72.0f);
+    assert(trace.changes.size() == 10);
+}
+
+static void TestRecovery()
+{
+    PerformanceTrace trace;
+    trace.Play(2000, 10.5f);
+    size_t escalationChanges = trace.changes.size();
+
+    // Light work, fits under 60% of the 90 Hz period.
+    trace.Play(3000, 4.0f);
+    std::vector<Change> recovery(trace.changes.begin() + escalationChanges, trace.changes.end());
+    std::vector<Change> policyChanges;
+    for (const Change& change : recovery)
+    {
+        if (change.kind != kResolutionChange)
+        {
+            policyChanges.push_back(change);
+        }
+    }
+    // The frame rate comes back first, then foveation steps down to none.
+    assert(policyChanges.size() == 5);
+    assert(policyChanges[0].kind == kFrameRateChange && policyChanges[0].value == 90.0f);
+    for (size_t i = 1; i < policyChanges.size(); ++i)
+    {
+        assert(policyChanges[i].kind == kFoveationChange);
+        assert(IsNear(policyChanges[i].value, 1.0f - 0.25f * i));
+    }
+    assert(IsNear(trace.governor.GetScale(), 1.0f));
+    assert(trace.policy.GetTargetFrameRate() == 90.0f);
+    assert(trace.policy.GetFoveationLevel() == 0.0f);
+}
+
+static void TestConfiguredFoveation()
+{
+    // The layer starts at 0.5, raising foveation goes on from there.
+    PerformanceTrace trace(0.5f);
+    assert(trace.policy.GetFoveationLevel() == 0.5f);
+    trace.Play(2000, 10.5f);
+    std::vector<Change> foveation = trace.Kinds(kFoveationChange);
+    assert(foveation.size() == 2);
+    assert(IsNear(foveation.front().value, 0.75f));
+
+    WebXRPerformancePolicy clamped;
+    clamped.Configure(true, kFrameRates, 3, 2.0f);
+    assert(clamped.GetFoveationLevel() == 1.0f);
+}
+
+static void TestAppRequests()
+{
+    WebXRPerformancePolicy policy;
+    // No frame rates known: nothing to pick from.
+    policy.Configure(true, kFrameRates, 0, 0.0f);
+    policy.SetTargetFrameRate(72.0f);
+    assert(policy.GetTargetFrameRate() == 0.0f);
+
+    // The closest supported rate, and the policy never goes above it.
+    policy.Configure(true, kFrameRates, 3, 0.0f);
+    policy.SetTargetFrameRate(75.0f);
+    assert(policy.GetTargetFrameRate() == 72.0f);
+    for (int i = 0; i < 2000; ++i)
+    {
+        policy.AddFrame(1000.0f / 72.0f, 2.0f, 1000.0f / 72.0f, 72.0f, false);
+    }
+    assert(policy.GetTargetFrameRate() == 72.0f);
+
+    // Disabled, requests still apply but frame times change nothing.
+    policy.SetEnabled(false);
+    policy.SetFoveationLevel(0.5f);
+    for (int i = 0; i < 2000; ++i)
+    {
+        assert(!policy.AddFrame(1000.0f / 72.0f, 20.0f, 1000.0f / 72.0f, 72.0f, false));
+    }
+    assert(policy.GetFoveationLevel() == 0.5f);
+    assert(policy.GetTargetFrameRate() == 72.0f);
+}
+
+int main()
+{
+    RUN_TEST(TestEscalationOrder);
+    RUN_TEST(TestRecovery);
+    RUN_TEST(TestConfiguredFoveation);
+    RUN_TEST(TestAppRequests);
+    return 0;
+}
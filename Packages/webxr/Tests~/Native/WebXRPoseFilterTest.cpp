@@ -0,0 +1,134 @@
+#include "WebXRPoseFilter.h"
+#include "WebXRTestUtils.h"
+
+static const double kFrameInterval = 1000.0 / 90.0;
+
+static UnityXRPose MakePose(float x, float yaw)
+{
+    UnityXRPose pose = {};
+    pose.position = {x, 1.5f, 0.0f};
+    pose.rotation = {0.0f, sinf(0.5f * yaw), 0.0f, cosf(0.5f * yaw)};
+    return pose;
+}
+
+static float GetYaw(const UnityXRVector4& rotation)
+{
+    float sign = rotation.w < 0.0f ? -1.0f : 1.0f;
+    return 2.0f * atan2f(sign * rotation.y, sign * rotation.w);
+}
+
+// Deterministic noise in [-1, 1].
+static float Noise(int frame)
+{
+    unsigned int hash = (unsigned int)frame * 2654435761u;
+    return (float)((hash >> 8) & 0xFFFF) / 32767.5f - 1.0f;
+}
+
+static void TestJitterDampedAtRest()
+{
+    WebXRPoseFilter filter;
+    WebXRPoseFilterParameters parameters;
+    // 1 mm and 0.2 degrees of tracking noise around a pose at rest.
+    const float positionNoise = 0.001f;
+    const float yawNoise = 0.0035f;
+    float inputSquares = 0.0f;
+    float outputSquares = 0.0f;
+    float yawSquares = 0.0f;
+    for (int frame = 0; frame < 600; ++frame)
+    {
+        UnityXRPose pose = MakePose(positionNoise * Noise(frame), yawNoise * Noise(frame + 1000));
+        const UnityXRPose& filtered = filter.Filter(frame * kFrameInterval, pose, parameters);
+        // Past the settling of the first frames.
+        if (frame >= 90)
+        {
+            inputSquares += pose.position.x * pose.position.x;
+            outputSquares += filtered.position.x * filtered.position.x;
+            float yaw = GetYaw(filtered.rotation);
+            yawSquares += yaw * yaw;
+        }
+        assert(IsNear(filtered.position.y, 1.5f));
+    }
+    // Less than a third of the noise goes through.
+    assert(sqrtf(outputSquares / inputSquares) < 0.33f);
+    assert(sqrtf(yawSquares / 510.0f) < yawNoise / 3.0f);
+}
+
+static void TestLagBoundedAtConstantVelocity()
+{
+    WebXRPoseFilter filter;
+    WebXRPoseFilterParameters parameters;
+    // 1 m/s and 2 rad/s, a quick hand motion.
+    const float speed = 1.0f;
+    const float yawRate = 2.0f;
+    float positionLags[2];
+    float yawLags[2];
+    for (int frame = 0; frame <= 180; ++frame)
+    {
+        float seconds = (float)(frame * kFrameInterval * 0.001);
+        UnityXRPose pose = MakePose(speed * seconds, fmodf(yawRate * seconds, 6.0f));
+        const UnityXRPose& filtered = filter.Filter(frame * kFrameInterval, pose, parameters);
+        float positionLag = pose.position.x - filtered.position.x;
+        float yawLag = GetYaw(pose.rotation) - GetYaw(filtered.rotation);
+        yawLag = yawLag > 3.14159265f ? yawLag - 6.2831853f : (yawLag < -3.14159265f ? yawLag + 6.2831853f : yawLag);
+        // The filter trails the motion, never overshoots it.
+        assert(positionLag >= -kTestEpsilon);
+        assert(yawLag >= -kTestEpsilon);
+        if (frame == 90 || frame == 180)
+        {
+            positionLags[frame / 90 - 1] = positionLag;
+            yawLags[frame / 90 - 1] = yawLag;
+        }
+    }
+    // Less than two frames of motion behind, with the cutoff raised by the speed...
+    float frameSeconds = (float)(kFrameInterval * 0.001);
+    assert(positionLags[1] < 2.0f * speed * frameSeconds);
+    assert(yawLags[1] < 2.0f * yawRate * frameSeconds);
+    // ...and settled, not growing with time.
+    assert(IsNear(positionLags[0], positionLags[1], 1e-3f));
+    assert(IsNear(yawLags[0], yawLags[1], 1e-3f));
+}
+
+static void TestResetAfterTrackingGap()
+{
+    WebXRPoseFilter filter;
+    WebXRPoseFilterParameters parameters;
+    assert(!filter.HasPose());
+    // The first pose goes through as is.
+    UnityXRPose first = MakePose(0.0f, 0.0f);
+    assert(IsNear(filter.Filter(0.0, first, parameters).position.x, 0.0f));
+    assert(filter.HasPose());
+
+    // A jump within the frame interval is smoothed.
+    UnityXRPose jumped = MakePose(0.5f, 1.0f);
+    double time = kFrameInterval;
+    const UnityXRPose& smoothed = filter.Filter(time, jumped, parameters);
+    assert(smoothed.position.x < 0.5f);
+    assert(GetYaw(smoothed.rotation) < 1.0f);
+
+    // After a gap longer than kMaxFrameInterval the filter restarts from the new pose instead of sliding to it.
+    time += WebXRPoseFilter::kMaxFrameInterval + 1.0;
+    UnityXRPose reacquired = MakePose(-0.3f, -0.5f);
+    const UnityXRPose& restarted = filter.Filter(time, reacquired, parameters);
+    assert(IsNear(restarted.position.x, -0.3f));
+    assert(IsNear(GetYaw(restarted.rotation), -0.5f));
+
+    // The speed estimate restarted too: a small step right after is damped like at rest.
+    UnityXRPose step = MakePose(-0.299f, -0.5f);
+    const UnityXRPose& afterGap = filter.Filter(time + kFrameInterval, step, parameters);
+    assert(afterGap.position.x < -0.2995f);
+
+    // Time going backwards, like a new session, restarts as well.
+    assert(IsNear(filter.Filter(0.0, first, parameters).position.x, 0.0f));
+
+    filter.Reset();
+    assert(!filter.HasPose());
+    assert(IsNear(filter.Filter(10.0, jumped, parameters).position.x, 0.5f));
+}
+
+int main()
+{
+    RUN_TEST(TestJitterDampedAtRest);
+    RUN_TEST(TestLagBoundedAtConstantVelocity);
+    RUN_TEST(TestResetAfterTrackingGap);
+    return 0;
+}
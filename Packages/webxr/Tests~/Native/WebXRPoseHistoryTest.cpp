@@ -0,0 +1,141 @@
+#include "WebXRPoseHistory.h"
+#include "WebXRTestUtils.h"
+
+static const double kStartTime = 1000.0;
+static const double kInterval = 10.0;
+// Yaw step between samples, in radians.
+static const float kYawStep = 0.01f;
+
+static UnityXRVector4 MakeYaw(float angle)
+{
+    return {0.0f, sinf(0.5f * angle), 0.0f, cosf(0.5f * angle)};
+}
+
+// Sample i is at x = i, turned i * kYawStep around y.
+static void AddSamples(WebXRPoseHistory& history, int first, int count)
+{
+    for (int i = first; i < first + count; ++i)
+    {
+        UnityXRPose pose = {};
+        pose.position = {(float)i, 0.0f, 0.0f};
+        pose.rotation = MakeYaw(i * kYawStep);
+        history.Add(kStartTime + i * kInterval, pose);
+    }
+}
+
+static double SampleTime(double index)
+{
+    return kStartTime + index * kInterval;
+}
+
+// q and -q are the same rotation, the yaw is read from the one with a positive w.
+static float GetYaw(const UnityXRVector4& rotation)
+{
+    float sign = rotation.w < 0.0f ? -1.0f : 1.0f;
+    return 2.0f * atan2f(sign * rotation.y, sign * rotation.w);
+}
+
+static void TestEmpty()
+{
+    WebXRPoseHistory history;
+    UnityXRPose pose;
+    WebXRPoseSample sample;
+    assert(history.IsEmpty());
+    assert(!history.Sample(kStartTime, pose));
+    assert(!history.GetLatest(sample));
+}
+
+static void TestOutOfRange()
+{
+    WebXRPoseHistory history;
+    AddSamples(history, 0, 10);
+    UnityXRPose pose;
+
+    // Before the oldest sample.
+    assert(!history.Sample(SampleTime(-0.5), pose));
+    // On the oldest and newest samples.
+    assert(history.Sample(SampleTime(0), pose) && IsNear(pose.position.x, 0.0f));
+    assert(history.Sample(SampleTime(9), pose) && IsNear(pose.position.x, 9.0f));
+    // After the newest sample, held at the newest pose.
+    assert(history.Sample(SampleTime(100), pose) && IsNear(pose.position.x, 9.0f));
+    assert(IsNear(GetYaw(pose.rotation), 9 * kYawStep));
+
+    // Older samples than the newest are ignored.
+    UnityXRPose stale = {};
+    stale.rotation.w = 1.0f;
+    history.Add(SampleTime(5), stale);
+    history.Add(SampleTime(9), stale);
+    WebXRPoseSample latest;
+    assert(history.GetLatest(latest));
+    assert(latest.time == SampleTime(9) && IsNear(latest.pose.position.x, 9.0f));
+
+    history.Clear();
+    assert(history.IsEmpty());
+    assert(!history.Sample(SampleTime(5), pose));
+}
+
+static void TestWraparound()
+{
+    WebXRPoseHistory history;
+    // Three times around the ring buffer.
+    const int count = 3 * WebXRPoseHistory::kCapacity + 7;
+    AddSamples(history, 0, count);
+    UnityXRPose pose;
+
+    // The slot next written is never read, kCapacity - 1 samples are left.
+    int oldest = count - (WebXRPoseHistory::kCapacity - 1);
+    assert(!history.Sample(SampleTime(oldest - 1), pose));
+    assert(!history.Sample(SampleTime(oldest - 0.5), pose));
+    assert(history.Sample(SampleTime(oldest), pose) && IsNear(pose.position.x, (float)oldest));
+
+    // Every interval of the buffer interpolates between its own two samples, across the wrap of the slots.
+    for (int i = oldest; i < count - 1; ++i)
+    {
+        assert(history.Sample(SampleTime(i + 0.25), pose));
+        assert(IsNear(pose.position.x, i + 0.25f, 1e-3f));
+    }
+
+    WebXRPoseSample latest;
+    assert(history.GetLatest(latest));
+    assert(latest.time == SampleTime(count - 1));
+}
+
+static void TestSlerpAtMidpoint()
+{
+    WebXRPoseHistory history;
+    UnityXRPose before = {};
+    before.position = {0.0f, 1.0f, 0.0f};
+    before.rotation = MakeYaw(0.0f);
+    UnityXRPose after = {};
+    after.position = {2.0f, 1.0f, -4.0f};
+    after.rotation = MakeYaw(1.2f);
+    history.Add(kStartTime, before);
+    history.Add(kStartTime + kInterval, after);
+
+    UnityXRPose pose;
+    assert(history.Sample(kStartTime + 0.5 * kInterval, pose));
+    assert(IsNear(pose.position.x, 1.0f) && IsNear(pose.position.y, 1.0f) && IsNear(pose.position.z, -2.0f));
+    // Half the angle, not a normalized average of the quaternions.
+    assert(IsNear(GetYaw(pose.rotation), 0.6f));
+    float length = sqrtf(pose.rotation.x * pose.rotation.x + pose.rotation.y * pose.rotation.y
+        + pose.rotation.z * pose.rotation.z + pose.rotation.w * pose.rotation.w);
+    assert(IsNear(length, 1.0f));
+
+    // The same rotation as a negated quaternion takes the shortest path too.
+    history.Clear();
+    UnityXRPose negated = after;
+    negated.rotation = {-after.rotation.x, -after.rotation.y, -after.rotation.z, -after.rotation.w};
+    history.Add(kStartTime, before);
+    history.Add(kStartTime + kInterval, negated);
+    assert(history.Sample(kStartTime + 0.5 * kInterval, pose));
+    assert(IsNear(GetYaw(pose.rotation), 0.6f));
+}
+
+int main()
+{
+    RUN_TEST(TestEmpty);
+    RUN_TEST(TestOutOfRange);
+    RUN_TEST(TestWraparound);
+    RUN_TEST(TestSlerpAtMidpoint);
+    return 0;
+}
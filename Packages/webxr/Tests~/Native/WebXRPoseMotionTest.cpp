@@ -0,0 +1,132 @@
+#include "WebXRPoseMotion.h"
+#include "WebXRTestUtils.h"
+
+static const double kFrameInterval = 1000.0 / 90.0;
+
+static UnityXRVector4 MakeYaw(float yaw)
+{
+    return {0.0f, sinf(0.5f * yaw), 0.0f, cosf(0.5f * yaw)};
+}
+
+static bool IsNearVector(const UnityXRVector3& v, float x, float y, float z, float eps = kTestEpsilon)
+{
+    return IsNear(v.x, x, eps) && IsNear(v.y, y, eps) && IsNear(v.z, z, eps);
+}
+
+// Same rotation, either sign.
+static bool IsNearRotation(const UnityXRVector4& a, const UnityXRVector4& b, float eps = kTestEpsilon)
+{
+    float dot = a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+    return IsNear(fabsf(dot), 1.0f, eps);
+}
+
+static void TestConstantVelocityTranslation()
+{
+    WebXRPoseMotion motion;
+    // 1.5 m/s along x, 0.5 m/s along -z, from rest with 2 m/s² along y.
+    const float acceleration = 2.0f;
+    UnityXRPose pose = {};
+    for (int frame = 0; frame < 10; ++frame)
+    {
+        float seconds = (float)(frame * kFrameInterval * 0.001);
+        pose.position = {1.5f * seconds, 1.6f + 0.5f * acceleration * seconds * seconds, -0.5f * seconds};
+        pose.rotation = {0.0f, 0.0f, 0.0f, 1.0f};
+        motion.Add(frame * kFrameInterval, pose);
+        assert(motion.HasVelocity() == (frame >= 1));
+        assert(motion.HasAcceleration() == (frame >= 2));
+    }
+    // The difference of the last two frames is the velocity half a frame back.
+    float midSeconds = (float)(8.5 * kFrameInterval * 0.001);
+    assert(IsNearVector(motion.GetVelocity(), 1.5f, acceleration * midSeconds, -0.5f, 1e-3f));
+    assert(IsNearVector(motion.GetAcceleration(), 0.0f, acceleration, 0.0f, 1e-2f));
+    assert(IsNearVector(motion.GetAngularVelocity(), 0.0f, 0.0f, 0.0f));
+    assert(IsNearVector(motion.GetAngularAcceleration(), 0.0f, 0.0f, 0.0f));
+
+    // Extrapolated along the velocity, the rotation is left as is.
+    UnityXRPose predicted = motion.Predict(pose, 0.02f);
+    assert(IsNear(predicted.position.x, pose.position.x + 1.5f * 0.02f));
+    assert(IsNear(predicted.position.z, pose.position.z - 0.5f * 0.02f));
+    assert(IsNearRotation(predicted.rotation, pose.rotation));
+}
+
+static void TestConstantYawRate()
+{
+    WebXRPoseMotion motion;
+    // 3 rad/s around the world up axis, on top of a head tilted 0.4 rad around x.
+    const float yawRate = 3.0f;
+    const UnityXRVector4 tilt = {sinf(0.2f), 0.0f, 0.0f, cosf(0.2f)};
+    UnityXRPose pose = {};
+    for (int frame = 0; frame < 10; ++frame)
+    {
+        float seconds = (float)(frame * kFrameInterval * 0.001);
+        pose.position = {0.0f, 1.6f, 0.0f};
+        pose.rotation = WebXRPoseMath::Multiply(MakeYaw(yawRate * seconds), tilt);
+        motion.Add(frame * kFrameInterval, pose);
+    }
+    // World space: around y only, whatever the tilt.
+    assert(IsNearVector(motion.GetAngularVelocity(), 0.0f, yawRate, 0.0f, 1e-3f));
+    assert(IsNearVector(motion.GetAngularAcceleration(), 0.0f, 0.0f, 0.0f, 1e-1f));
+    assert(IsNearVector(motion.GetVelocity(), 0.0f, 0.0f, 0.0f));
+
+    UnityXRPose predicted = motion.Predict(pose, 0.03f);
+    float seconds = (float)(9 * kFrameInterval * 0.001) + 0.03f;
+    assert(IsNearRotation(predicted.rotation, WebXRPoseMath::Multiply(MakeYaw(yawRate * seconds), tilt), 1e-5f));
+    assert(IsNearVector(predicted.position, 0.0f, 1.6f, 0.0f));
+}
+
+static void TestPredictionCapped()
+{
+    WebXRPoseMotion motion;
+    UnityXRPose pose = {};
+    pose.rotation = {0.0f, 0.0f, 0.0f, 1.0f};
+    motion.Add(0.0, pose);
+    // Nothing to extrapolate with from a single pose.
+    assert(IsNear(motion.Predict(pose, 0.02f).position.x, 0.0f));
+
+    pose.position.x = 0.01f;
+    pose.rotation = MakeYaw(0.01f);
+    motion.Add(10.0, pose);
+    // 1 m/s and 1 rad/s.
+    assert(IsNear(motion.Predict(pose, 0.04f).position.x, 0.05f));
+    // A stale predicted display time extrapolates no further than kMaxPredictionSeconds.
+    UnityXRPose capped = motion.Predict(pose, 0.5f);
+    assert(IsNear(capped.position.x, 0.01f + WebXRPoseMotion::kMaxPredictionSeconds));
+    assert(IsNearRotation(capped.rotation, MakeYaw(0.01f + WebXRPoseMotion::kMaxPredictionSeconds)));
+    // A display time in the past doesn't extrapolate backwards.
+    assert(IsNear(motion.Predict(pose, -0.02f).position.x, 0.01f));
+}
+
+static void TestRestartAfterTrackingGap()
+{
+    WebXRPoseMotion motion;
+    UnityXRPose pose = {};
+    pose.rotation = {0.0f, 0.0f, 0.0f, 1.0f};
+    for (int frame = 0; frame < 3; ++frame)
+    {
+        pose.position.x = 0.01f * frame;
+        motion.Add(frame * 10.0, pose);
+    }
+    assert(IsNear(motion.GetVelocity().x, 1.0f));
+
+    // The same time again is the same XR frame.
+    pose.position.x = 1.0f;
+    motion.Add(20.0, pose);
+    assert(IsNear(motion.GetVelocity().x, 1.0f));
+
+    // Longer than kMaxFrameInterval since the last pose: no velocity across the gap.
+    motion.Add(20.0 + WebXRPoseMotion::kMaxFrameInterval + 1.0, pose);
+    assert(!motion.HasVelocity());
+    assert(IsNearVector(motion.GetVelocity(), 0.0f, 0.0f, 0.0f));
+
+    motion.Reset();
+    assert(!motion.HasVelocity() && !motion.HasAcceleration());
+}
+
+int main()
+{
+    RUN_TEST(TestConstantVelocityTranslation);
+    RUN_TEST(TestConstantYawRate);
+    RUN_TEST(TestPredictionCapped);
+    RUN_TEST(TestRestartAfterTrackingGap);
+    return 0;
+}
@@ -0,0 +1,148 @@
+#include "WebXRResolutionGovernor.h"
+#include "WebXRTestUtils.h"
+
+#include <vector>
+
+// Run of frames with the same timings, in milliseconds, recorded at 90 Hz.
+struct TraceSegment
+{
+    int frames;
+    float interval;
+    float work;
+};
+
+static const float kPeriod = 11.1f;
+// Over 90% of the period.
+static const float kOverWork = 10.5f;
+// Between 65% and 90% of the period, in the hysteresis band.
+static const float kBandWork = 8.5f;
+// Under 65% of the period.
+static const float kUnderWork = 5.0f;
+
+// Feeds the trace, returns the frame index and new scale of every change.
+static std::vector<std::pair<int, float>> Play(WebXRResolutionGovernor& governor, const std::vector<TraceSegment>& trace)
+{
+    std::vector<std::pair<int, float>> changes;
+    int frame = 0;
+    for (const TraceSegment& segment : trace)
+    {
+        for (int i = 0; i < segment.frames; ++i, ++frame)
+        {
+            if (governor.AddFrame(segment.interval, segment.work))
+            {
+                changes.push_back(std::make_pair(frame, governor.GetScale()));
+            }
+        }
+    }
+    return changes;
+}
+
+static WebXRResolutionGovernor MakeGovernor()
+{
+    WebXRResolutionGovernor governor;
+    governor.Configure(true, 0.5f, 1.0f);
+    return governor;
+}
+
+static void TestStepDown()
+{
+    WebXRResolutionGovernor governor = MakeGovernor();
+    // Frames within budget, then three over it: one step down, on the third.
+    auto changes = Play(governor, {{10, kPeriod, kBandWork}, {3, kPeriod, kOverWork}});
+    assert(changes.size() == 1);
+    assert(changes[0].first == 12);
+    assert(IsNear(changes[0].second, 0.9f));
+    assert(IsNear(governor.GetFramePeriod(), kPeriod));
+}
+
+static void TestLateFramesAreOverBudget()
+{
+    WebXRResolutionGovernor governor = MakeGovernor();
+    // Light work, but every other refresh missed: the browser blocked outside of the Unity frame.
+    auto changes = Play(governor, {{10, kPeriod, kBandWork}, {3, 2.0f * kPeriod, kUnderWork}});
+    assert(changes.size() == 1);
+    assert(changes[0].first == 12);
+}
+
+static void TestHysteresis()
+{
+    WebXRResolutionGovernor governor = MakeGovernor();
+    // Over budget spikes shorter than three frames, broken by frames in the band, never drop.
+    std::vector<TraceSegment> trace = {{10, kPeriod, kBandWork}};
+    for (int i = 0; i < 20; ++i)
+    {
+        trace.push_back({2, kPeriod, kOverWork});
+        trace.push_back({1, kPeriod, kBandWork});
+    }
+    assert(Play(governor, trace).empty());
+    assert(IsNear(governor.GetScale(), 1.0f));
+
+    // Once down, frames in the band never raise the scale back.
+    Play(governor, {{3, kPeriod, kOverWork}});
+    assert(IsNear(governor.GetScale(), 0.9f));
+    assert(Play(governor, {{200, kPeriod, kBandWork}}).empty());
+
+    // Under budget runs shorter than 45 frames don't either.
+    trace.clear();
+    for (int i = 0; i < 5; ++i)
+    {
+        trace.push_back({44, kPeriod, kUnderWork});
+        trace.push_back({1, kPeriod, kBandWork});
+    }
+    assert(Play(governor, trace).empty());
+
+    // 45 in a row step back up.
+    auto changes = Play(governor, {{45, kPeriod, kUnderWork}});
+    assert(changes.size() == 1);
+    assert(changes[0].first == 44);
+    assert(IsNear(changes[0].second, 1.0f));
+}
+
+static void TestCooldown()
+{
+    WebXRResolutionGovernor governor = MakeGovernor();
+    // A long over budget run: one step, 15 frames of cooldown, then the next three frames step again.
+    auto changes = Play(governor, {{10, kPeriod, kBandWork}, {50, kPeriod, kOverWork}});
+    assert(changes.size() == 3);
+    assert(changes[0].first == 12);
+    assert(changes[1].first == 12 + 15 + 3);
+    assert(changes[2].first == 12 + 2 * (15 + 3));
+    assert(IsNear(changes[2].second, 0.7f));
+
+    // Frames during the cooldown don't count toward the next change.
+    governor = MakeGovernor();
+    changes = Play(governor, {{10, kPeriod, kBandWork}, {3, kPeriod, kOverWork}, {15, kPeriod, kOverWork}, {2, kPeriod, kOverWork}});
+    assert(changes.size() == 1);
+}
+
+static void TestClampedToRange()
+{
+    WebXRResolutionGovernor governor = MakeGovernor();
+    Play(governor, {{10, kPeriod, kBandWork}, {500, kPeriod, kOverWork}});
+    assert(IsNear(governor.GetScale(), 0.5f));
+    assert(governor.IsAtMinScale());
+
+    Play(governor, {{2000, kPeriod, kUnderWork}});
+    assert(IsNear(governor.GetScale(), 1.0f));
+    assert(!governor.IsAtMinScale());
+}
+
+static void TestDisabled()
+{
+    WebXRResolutionGovernor governor;
+    governor.Configure(false, 0.5f, 1.0f);
+    assert(Play(governor, {{10, kPeriod, kBandWork}, {100, kPeriod, kOverWork}}).empty());
+    assert(IsNear(governor.GetScale(), 1.0f));
+    assert(governor.IsAtMinScale());
+}
+
+int main()
+{
+    RUN_TEST(TestStepDown);
+    RUN_TEST(TestLateFramesAreOverBudget);
+    RUN_TEST(TestHysteresis);
+    RUN_TEST(TestCooldown);
+    RUN_TEST(TestClampedToRange);
+    RUN_TEST(TestDisabled);
+    return 0;
+}
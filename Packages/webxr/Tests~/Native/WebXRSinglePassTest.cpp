@@ -0,0 +1,135 @@
+#include "WebXRSinglePass.h"
+#include "WebXRTestUtils.h"
+
+// Asymmetric views: the right one is larger, both at the bottom of a padded framebuffer.
+static const float kViewports[] = {
+    1000.0f, 900.0f, 0.0f, 0.0f,
+    1100.0f, 1000.0f, 1000.0f, 0.0f
+};
+static const float kFramebufferWidth = 2200.0f;
+static const float kFramebufferHeight = 1000.0f;
+static const UnityXRRectf kFullViewport = {0.0f, 0.0f, 1.0f, 1.0f};
+static const UnityXRRenderTextureId kTextureId = 42;
+
+static WebXRViewLayout MakeLayout()
+{
+    WebXRViewLayout layout;
+    layout.Update(kViewports, 2, kFramebufferWidth, kFramebufferHeight);
+    return layout;
+}
+
+static void MakeEyes(WebXRSinglePassEye* eyes)
+{
+    for (int eye = 0; eye < WebXRSinglePass::kEyesCount; ++eye)
+    {
+        eyes[eye].pose = {};
+        eyes[eye].pose.position.x = eye == 0 ? -0.032f : 0.032f;
+        eyes[eye].pose.rotation.w = 1.0f;
+        eyes[eye].projection.type = kUnityXRProjectionTypeMatrix;
+        eyes[eye].projection.data.matrix = eye == 0 ? MakeProjection(-1.2f, 1.0f, -1.1f, 1.0f) : MakeProjection(-1.0f, 1.2f, -1.1f, 1.0f);
+        eyes[eye].occlusionMeshId = (UnityXROcclusionMeshId)(eye + 1);
+    }
+}
+
+static void TestEyesAreCopied(const UnityXRNextFrameDesc::UnityXRRenderPass& renderPass, const WebXRSinglePassEye* eyes)
+{
+    assert(renderPass.textureId == kTextureId);
+    assert(renderPass.renderParamsCount == 2);
+    assert(renderPass.cullingPassIndex == 0);
+    for (int eye = 0; eye < WebXRSinglePass::kEyesCount; ++eye)
+    {
+        const auto& renderParams = renderPass.renderParams[eye];
+        assert(IsNear(renderParams.deviceAnchorToEyePose.position.x, eyes[eye].pose.position.x));
+        assert(IsNear(renderParams.projection.data.matrix.columns[2].x, eyes[eye].projection.data.matrix.columns[2].x));
+        assert(renderParams.occlusionMeshId == eyes[eye].occlusionMeshId);
+    }
+}
+
+static void TestSideBySide()
+{
+    WebXRViewLayout layout = MakeLayout();
+    WebXRSinglePassEye eyes[WebXRSinglePass::kEyesCount];
+    MakeEyes(eyes);
+
+    // One texture covering the bounding rect of the views.
+    assert(layout.GetTextureWidth(kWebXRTextureLayoutSideBySide) == 2100);
+    assert(layout.GetTextureHeight(kWebXRTextureLayoutSideBySide) == 1000);
+    assert(layout.GetTextureArrayLength(kWebXRTextureLayoutSideBySide) == 0);
+
+    UnityXRNextFrameDesc nextFrame = {};
+    WebXRSinglePass::Fill(layout, kWebXRTextureLayoutSideBySide, kTextureId, eyes, kFullViewport, 1.0f, nextFrame.renderPasses[0]);
+    const auto& renderPass = nextFrame.renderPasses[0];
+    TestEyesAreCopied(renderPass, eyes);
+
+    assert(renderPass.renderParams[0].textureArraySlice == 0);
+    assert(renderPass.renderParams[1].textureArraySlice == 0);
+    assert(IsNearRect(renderPass.renderParams[0].viewportRect, {0.0f, 0.0f, 1000.0f / 2100.0f, 0.9f}));
+    assert(IsNearRect(renderPass.renderParams[1].viewportRect, {1000.0f / 2100.0f, 0.0f, 1100.0f / 2100.0f, 1.0f}));
+}
+
+static void TestTextureArray()
+{
+    WebXRViewLayout layout = MakeLayout();
+    WebXRSinglePassEye eyes[WebXRSinglePass::kEyesCount];
+    MakeEyes(eyes);
+
+    // Two slices as large as the largest view.
+    assert(layout.GetTextureWidth(kWebXRTextureLayoutTextureArray) == 1100);
+    assert(layout.GetTextureHeight(kWebXRTextureLayoutTextureArray) == 1000);
+    assert(layout.GetTextureArrayLength(kWebXRTextureLayoutTextureArray) == 2);
+
+    UnityXRNextFrameDesc nextFrame = {};
+    WebXRSinglePass::Fill(layout, kWebXRTextureLayoutTextureArray, kTextureId, eyes, kFullViewport, 1.0f, nextFrame.renderPasses[0]);
+    const auto& renderPass = nextFrame.renderPasses[0];
+    TestEyesAreCopied(renderPass, eyes);
+
+    // Each eye in its slice, from the slice origin.
+    assert(renderPass.renderParams[0].textureArraySlice == 0);
+    assert(renderPass.renderParams[1].textureArraySlice == 1);
+    assert(IsNearRect(renderPass.renderParams[0].viewportRect, {0.0f, 0.0f, 1000.0f / 1100.0f, 0.9f}));
+    assert(IsNearRect(renderPass.renderParams[1].viewportRect, kFullViewport));
+}
+
+static void TestFramebuffer()
+{
+    WebXRViewLayout layout = MakeLayout();
+    WebXRSinglePassEye eyes[WebXRSinglePass::kEyesCount];
+    MakeEyes(eyes);
+
+    // The layer texture is the whole framebuffer, padding included.
+    assert(layout.GetTextureWidth(kWebXRTextureLayoutFramebuffer) == 2200);
+    assert(layout.GetTextureHeight(kWebXRTextureLayoutFramebuffer) == 1000);
+    assert(layout.GetTextureArrayLength(kWebXRTextureLayoutFramebuffer) == 0);
+
+    UnityXRNextFrameDesc nextFrame = {};
+    WebXRSinglePass::Fill(layout, kWebXRTextureLayoutFramebuffer, kTextureId, eyes, kFullViewport, 1.0f, nextFrame.renderPasses[0]);
+    const auto& renderPass = nextFrame.renderPasses[0];
+    assert(renderPass.renderParams[1].textureArraySlice == 0);
+    assert(IsNearRect(renderPass.renderParams[1].viewportRect, {1000.0f / 2200.0f, 0.0f, 1100.0f / 2200.0f, 1.0f}));
+}
+
+static void TestRenderViewportAndScale()
+{
+    WebXRViewLayout layout = MakeLayout();
+    WebXRSinglePassEye eyes[WebXRSinglePass::kEyesCount];
+    MakeEyes(eyes);
+    const UnityXRRectf renderViewport = {0.0f, 0.0f, 0.8f, 0.8f};
+
+    // Both shrink each view from its origin, the views never overlap.
+    UnityXRNextFrameDesc nextFrame = {};
+    WebXRSinglePass::Fill(layout, kWebXRTextureLayoutSideBySide, kTextureId, eyes, renderViewport, 0.5f, nextFrame.renderPasses[0]);
+    assert(IsNearRect(nextFrame.renderPasses[0].renderParams[1].viewportRect, {1000.0f / 2100.0f, 0.0f, 0.4f * 1100.0f / 2100.0f, 0.4f}));
+
+    WebXRSinglePass::Fill(layout, kWebXRTextureLayoutTextureArray, kTextureId, eyes, renderViewport, 0.5f, nextFrame.renderPasses[0]);
+    assert(IsNearRect(nextFrame.renderPasses[0].renderParams[0].viewportRect, {0.0f, 0.0f, 0.4f * 1000.0f / 1100.0f, 0.4f * 0.9f}));
+    assert(IsNearRect(nextFrame.renderPasses[0].renderParams[1].viewportRect, {0.0f, 0.0f, 0.4f, 0.4f}));
+}
+
+int main()
+{
+    RUN_TEST(TestSideBySide);
+    RUN_TEST(TestTextureArray);
+    RUN_TEST(TestFramebuffer);
+    RUN_TEST(TestRenderViewportAndScale);
+    return 0;
+}
@@ -0,0 +1,105 @@
+#include "WebXRSpectatorView.h"
+#include "WebXRTestUtils.h"
+
+static const float kDegreesToRadians = 3.14159265f / 180.0f;
+
+static UnityXRPose MakePose(float x, float y, float z, float yawDegrees = 0.0f)
+{
+    float halfAngle = 0.5f * yawDegrees * kDegreesToRadians;
+    UnityXRPose pose = {};
+    pose.position = {x, y, z};
+    pose.rotation = {0.0f, sinf(halfAngle), 0.0f, cosf(halfAngle)};
+    return pose;
+}
+
+// Culling frustum 60 degrees to each side and 45 up and down, from 5 cm behind the head
+// like the combined culling pass of the eyes.
+static UnityXRNextFrameDesc::UnityXRCullingPass MakeCullingPass(float yawDegrees = 0.0f)
+{
+    float side = tanf(60.0f * kDegreesToRadians);
+    UnityXRNextFrameDesc::UnityXRCullingPass cullingPass = {};
+    cullingPass.deviceAnchorToCullingPose = MakePose(0.0f, 0.0f, -0.05f, yawDegrees);
+    cullingPass.projection.type = kUnityXRProjectionTypeMatrix;
+    cullingPass.projection.data.matrix = MakeProjection(-side, side, -1.0f, 1.0f, 0.15f, 200.05f);
+    cullingPass.separation = 0.064f;
+    return cullingPass;
+}
+
+static bool IsInside(const UnityXRPose& pose, float fieldOfView, float aspect, const UnityXRNextFrameDesc::UnityXRCullingPass& cullingPass)
+{
+    WebXRSpectatorView view;
+    view.Set(true, pose, fieldOfView, aspect, 0.5f);
+    // Eye near and far planes: 10 cm to 100 m.
+    UnityXRMatrix4x4 projection = view.GetProjection(MakeProjection(-1.0f, 1.0f, -1.0f, 1.0f, 0.1f, 100.0f)).data.matrix;
+    return view.IsInsideCullingPass(cullingPass, projection);
+}
+
+static void TestFieldOfView()
+{
+    UnityXRNextFrameDesc::UnityXRCullingPass cullingPass = MakeCullingPass();
+    assert(IsInside(MakePose(0.0f, 0.0f, 0.0f), 60.0f, 16.0f / 9.0f, cullingPass));
+    // Up to the top and bottom planes of the culling frustum.
+    assert(IsInside(MakePose(0.0f, 0.0f, 0.0f), 89.0f, 1.0f, cullingPass));
+    assert(!IsInside(MakePose(0.0f, 0.0f, 0.0f), 91.0f, 1.0f, cullingPass));
+    // Wider than the sides.
+    assert(!IsInside(MakePose(0.0f, 0.0f, 0.0f), 60.0f, 4.0f, cullingPass));
+}
+
+static void TestPosition()
+{
+    UnityXRNextFrameDesc::UnityXRCullingPass cullingPass = MakeCullingPass();
+    // Forward keeps the spectator inside, as long as the far corners are within the far plane.
+    assert(IsInside(MakePose(0.0f, 0.0f, 0.5f), 60.0f, 1.0f, cullingPass));
+    assert(!IsInside(MakePose(0.0f, 0.0f, 100.1f), 60.0f, 1.0f, cullingPass));
+    // Behind the culling origin, even by less than the eyes separation.
+    assert(!IsInside(MakePose(0.0f, 0.0f, -0.06f), 60.0f, 1.0f, cullingPass));
+    // Moved up with a field of view at the edge of the culling frustum: within the margin of
+    // the culling origin pulled back it fits, further up the frustum pokes out next to the near plane.
+    assert(IsInside(MakePose(0.0f, 0.03f, 0.0f), 89.0f, 1.0f, cullingPass));
+    assert(!IsInside(MakePose(0.0f, 0.08f, 0.0f), 89.0f, 1.0f, cullingPass));
+}
+
+static void TestRotation()
+{
+    UnityXRNextFrameDesc::UnityXRCullingPass cullingPass = MakeCullingPass();
+    // Turned at the head, its near corners come closer than the shared near plane.
+    assert(!IsInside(MakePose(0.0f, 0.0f, 0.0f, 20.0f), 60.0f, 1.0f, cullingPass));
+
+    // A bit forward, a 60 by 60 degrees view turned 20 degrees still fits in the 60 degrees sides, turned 40 it doesn't.
+    assert(IsInside(MakePose(0.0f, 0.0f, 0.05f, 20.0f), 60.0f, 1.0f, cullingPass));
+    assert(IsInside(MakePose(0.0f, 0.0f, 0.05f, -20.0f), 60.0f, 1.0f, cullingPass));
+    assert(!IsInside(MakePose(0.0f, 0.0f, 0.05f, 40.0f), 60.0f, 1.0f, cullingPass));
+    assert(!IsInside(MakePose(0.0f, 0.0f, 0.05f, 180.0f), 10.0f, 1.0f, cullingPass));
+
+    // The rotation of the culling pose is taken into account.
+    UnityXRNextFrameDesc::UnityXRCullingPass turnedPass = MakeCullingPass(40.0f);
+    UnityXRVector3 forward = WebXRPoseMath::Rotate(turnedPass.deviceAnchorToCullingPose.rotation, {0.0f, 0.0f, 0.1f});
+    assert(IsInside(MakePose(forward.x, forward.y, forward.z - 0.05f, 40.0f), 60.0f, 1.0f, turnedPass));
+    assert(!IsInside(MakePose(forward.x, forward.y, forward.z - 0.05f, -20.0f), 60.0f, 1.0f, turnedPass));
+}
+
+static void TestProjection()
+{
+    WebXRSpectatorView view;
+    view.Set(true, MakePose(0.0f, 0.0f, 0.0f), 90.0f, 2.0f, 0.5f);
+    UnityXRMatrix4x4 eyeProjection = MakeProjection(-1.2f, 1.0f, -1.0f, 1.1f, 0.1f, 100.0f);
+    UnityXRMatrix4x4 projection = view.GetProjection(eyeProjection).data.matrix;
+    UnityXRMatrix4x4 expected = MakeProjection(-2.0f, 2.0f, -1.0f, 1.0f, 0.1f, 100.0f);
+    const float* a = &projection.columns[0].x;
+    const float* b = &expected.columns[0].x;
+    for (int i = 0; i < 16; ++i)
+    {
+        assert(IsNear(a[i], b[i]));
+    }
+    assert(view.GetTextureWidth(1000.0f) == 1000);
+    assert(view.GetTextureHeight(1000.0f) == 500);
+}
+
+int main()
+{
+    RUN_TEST(TestFieldOfView);
+    RUN_TEST(TestPosition);
+    RUN_TEST(TestRotation);
+    RUN_TEST(TestProjection);
+    return 0;
+}
@@ -0,0 +1,184 @@
+#include "WebXRStatsReporter.h"
+#include "WebXRTestUtils.h"
+
+#include <cstring>
+
+static const float kPeriod90Hz = 1000.0f / 90.0f;
+
+// XR stats interface of the engine, keeps the values set for each registered tag.
+struct MockStat
+{
+    const char* tag;
+    float value;
+};
+
+static MockStat s_MockStats[32];
+static int s_MockStatsCount;
+static UnitySubsystemHandle s_MockStatSource;
+
+static UnitySubsystemErrorCode UNITY_INTERFACE_API MockRegisterStatSource(UnitySubsystemHandle handle)
+{
+    s_MockStatSource = handle;
+    return kUnitySubsystemErrorCodeSuccess;
+}
+
+static UnitySubsystemErrorCode UNITY_INTERFACE_API MockRegisterStatDefinition(UnitySubsystemHandle handle, const char* tag, unsigned int, UnityXRStatId* statId)
+{
+    assert(handle == s_MockStatSource);
+    s_MockStats[s_MockStatsCount] = {tag, -1.0f};
+    *statId = &s_MockStats[s_MockStatsCount++];
+    return kUnitySubsystemErrorCodeSuccess;
+}
+
+static UnitySubsystemErrorCode UNITY_INTERFACE_API MockSetStatFloat(UnityXRStatId statId, float value)
+{
+    static_cast<MockStat*>(statId)->value = value;
+    return kUnitySubsystemErrorCodeSuccess;
+}
+
+static IUnityXRStats MakeMockStats()
+{
+    s_MockStatsCount = 0;
+    s_MockStatSource = NULL;
+    IUnityXRStats stats;
+    stats.RegisterStatSource = MockRegisterStatSource;
+    stats.RegisterStatDefinition = MockRegisterStatDefinition;
+    stats.SetStatFloat = MockSetStatFloat;
+    return stats;
+}
+
+static float GetMockStat(const char* tag)
+{
+    for (int i = 0; i < s_MockStatsCount; ++i)
+    {
+        if (strcmp(s_MockStats[i].tag, tag) == 0)
+        {
+            return s_MockStats[i].value;
+        }
+    }
+    assert(false);
+    return 0.0f;
+}
+
+// Adds frames every period from frame number firstFrame on, returns the time of the next one.
+static float AddFrames(WebXRStatsReporter& reporter, int firstFrame, int count, float time, float period, float nominalRefreshRate = 0.0f)
+{
+    for (int frame = firstFrame; frame < firstFrame + count; ++frame)
+    {
+        reporter.AddFrame(frame, time, 0.0f, nominalRefreshRate);
+        time += period;
+    }
+    return time;
+}
+
+static void TestDroppedFramesFromGaps()
+{
+    WebXRStatsReporter reporter;
+    reporter.Reset();
+    float time = AddFrames(reporter, 0, 10, 0.0f, kPeriod90Hz);
+    assert(reporter.GetDroppedFrameCount() == 0);
+    assert(reporter.GetFramePresentCount() == 1);
+
+    // A frame two periods late, the previous one stayed for three refreshes.
+    time += 2.0f * kPeriod90Hz;
+    time = AddFrames(reporter, 10, 1, time, kPeriod90Hz);
+    assert(reporter.GetFramePresentCount() == 3);
+    assert(reporter.GetDroppedFrameCount() == 2);
+
+    // Jitter under half a period doesn't count as a dropped frame.
+    time += 0.4f * kPeriod90Hz;
+    time = AddFrames(reporter, 11, 1, time, kPeriod90Hz);
+    assert(reporter.GetFramePresentCount() == 1);
+    assert(reporter.GetDroppedFrameCount() == 2);
+
+    // The count is cumulative, one more late frame adds to it.
+    time += kPeriod90Hz;
+    AddFrames(reporter, 12, 1, time, kPeriod90Hz);
+    assert(reporter.GetFramePresentCount() == 2);
+    assert(reporter.GetDroppedFrameCount() == 3);
+
+    // The same frame number again is the same XR frame.
+    assert(!reporter.AddFrame(12, time + 100.0f, 0.0f, 0.0f));
+    assert(reporter.GetDroppedFrameCount() == 3);
+
+    reporter.Reset();
+    assert(reporter.GetDroppedFrameCount() == 0);
+    assert(reporter.GetRefreshRate() == 0.0f);
+}
+
+static void TestRefreshRateEstimation()
+{
+    WebXRStatsReporter reporter;
+    reporter.Reset();
+    // No interval yet on the first frame.
+    reporter.AddFrame(0, 0.0f, 0.0f, 0.0f);
+    assert(reporter.GetRefreshRate() == 0.0f);
+
+    // Late frames don't lower the estimate, the shortest interval is the refresh period.
+    float time = AddFrames(reporter, 1, 20, kPeriod90Hz, kPeriod90Hz);
+    time = AddFrames(reporter, 21, 5, time + kPeriod90Hz, 2.0f * kPeriod90Hz);
+    assert(IsNear(reporter.GetRefreshRate(), 90.0f, 0.01f));
+
+    // XRSession.frameRate wins over the estimate.
+    reporter.AddFrame(26, time, 0.0f, 72.0f);
+    assert(IsNear(reporter.GetRefreshRate(), 72.0f));
+}
+
+static void TestMotionToPhoton()
+{
+    WebXRStatsReporter reporter;
+    reporter.Reset();
+    reporter.AddFrame(0, 0.0f, 0.0f, 90.0f);
+    // One refresh period without a predicted display time, in seconds.
+    assert(IsNear(reporter.GetMotionToPhoton(), kPeriod90Hz * 0.001f));
+    reporter.AddFrame(1, kPeriod90Hz, kPeriod90Hz + 25.0f, 90.0f);
+    assert(IsNear(reporter.GetMotionToPhoton(), 0.025f));
+}
+
+static void TestPublish()
+{
+    UnitySubsystemHandle handle = (UnitySubsystemHandle)0x1234;
+    IUnityXRStats stats = MakeMockStats();
+    WebXRStatsReporter reporter;
+    reporter.Register(&stats, handle);
+    assert(s_MockStatSource == handle);
+    assert(s_MockStatsCount == 5 + kWebXRStatsGPUTimePassCount);
+
+    reporter.Reset();
+    float time = AddFrames(reporter, 0, 5, 0.0f, kPeriod90Hz);
+    time += kPeriod90Hz;
+    AddFrames(reporter, 5, 1, time, kPeriod90Hz);
+    reporter.Publish();
+    assert(GetMockStat(kUnityStatsDroppedFrameCount) == 1.0f);
+    assert(GetMockStat(kUnityStatsFramePresentCount) == 2.0f);
+    assert(IsNear(GetMockStat(kUnityStatsDisplayRefreshRate), 90.0f, 0.01f));
+    assert(IsNear(GetMockStat(kUnityStatsMotionToPhoton), kPeriod90Hz * 0.001f));
+    assert(GetMockStat(kUnityStatsGPUTimeApp) == 0.0f);
+
+    // GPU times are published with the next frames once read back.
+    const float passTimes[] = {0.004f, 0.003f};
+    reporter.AddGpuFrame(0.007f, passTimes, 2);
+    reporter.Publish();
+    assert(IsNear(GetMockStat(kUnityStatsGPUTimeApp), 0.007f));
+    assert(IsNear(GetMockStat("GPUAppLastFrameTimePass0"), 0.004f));
+    assert(IsNear(GetMockStat("GPUAppLastFrameTimePass1"), 0.003f));
+    assert(GetMockStat("GPUAppLastFrameTimePass2") == 0.0f);
+
+    // Without the engine interface nothing is published, the stats are still computed.
+    WebXRStatsReporter unregistered;
+    unregistered.Register(NULL, handle);
+    unregistered.Reset();
+    AddFrames(unregistered, 0, 2, 0.0f, 2.0f * kPeriod90Hz, 90.0f);
+    unregistered.Publish();
+    assert(unregistered.GetDroppedFrameCount() == 1);
+    assert(GetMockStat(kUnityStatsDroppedFrameCount) == 1.0f);
+}
+
+int main()
+{
+    RUN_TEST(TestDroppedFramesFromGaps);
+    RUN_TEST(TestRefreshRateEstimation);
+    RUN_TEST(TestMotionToPhoton);
+    RUN_TEST(TestPublish);
+    return 0;
+}
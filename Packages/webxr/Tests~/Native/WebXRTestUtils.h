@@ -0,0 +1,42 @@
+#pragma once
+
+#include "UnityHeaders/UnityXRTypes.h"
+
+#include <cassert>
+#include <cmath>
+#include <cstdio>
+
+static const float kTestEpsilon = 1e-4f;
+
+inline bool IsNear(float a, float b, float epsilon = kTestEpsilon)
+{
+    return fabsf(a - b) <= epsilon;
+}
+
+inline bool IsNearRect(const UnityXRRectf& a, const UnityXRRectf& b, float epsilon = kTestEpsilon)
+{
+    return IsNear(a.x, b.x, epsilon) && IsNear(a.y, b.y, epsilon)
+        && IsNear(a.width, b.width, epsilon) && IsNear(a.height, b.height, epsilon);
+}
+
+// OpenGL style projection, column major like the ones webxr.jspre shares, from the tangents of the half angles.
+// left and bottom are negative for a frustum around the view direction.
+inline UnityXRMatrix4x4 MakeProjection(float left, float right, float bottom, float top, float nearPlane = 0.1f, float farPlane = 100.0f)
+{
+    UnityXRMatrix4x4 matrix = {};
+    matrix.columns[0].x = 2.0f / (right - left);
+    matrix.columns[1].y = 2.0f / (top - bottom);
+    matrix.columns[2].x = (right + left) / (right - left);
+    matrix.columns[2].y = (top + bottom) / (top - bottom);
+    matrix.columns[2].z = -(farPlane + nearPlane) / (farPlane - nearPlane);
+    matrix.columns[2].w = -1.0f;
+    matrix.columns[3].z = -2.0f * farPlane * nearPlane / (farPlane - nearPlane);
+    return matrix;
+}
+
+#define RUN_TEST(test)                  \
+    do                                  \
+    {                                   \
+        test();                         \
+        printf("%s passed\n", #test);   \
+    } while (0)
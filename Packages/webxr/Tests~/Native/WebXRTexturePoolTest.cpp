@@ -0,0 +1,152 @@
+#include "WebXRTexturePool.h"
+#include "WebXRTestUtils.h"
+
+// Display interface of the engine, counts the textures alive.
+static UnityXRRenderTextureId s_NextTextureId;
+static int s_CreatedCount;
+static int s_DestroyedCount;
+
+static UnitySubsystemErrorCode UNITY_INTERFACE_API MockCreateTexture(UnitySubsystemHandle, const UnityXRRenderTextureDesc*, UnityXRRenderTextureId* textureId)
+{
+    *textureId = ++s_NextTextureId;
+    s_CreatedCount++;
+    return kUnitySubsystemErrorCodeSuccess;
+}
+
+static UnitySubsystemErrorCode UNITY_INTERFACE_API MockDestroyTexture(UnitySubsystemHandle, UnityXRRenderTextureId)
+{
+    s_DestroyedCount++;
+    return kUnitySubsystemErrorCodeSuccess;
+}
+
+static IUnityXRDisplayInterface MakeMockDisplay()
+{
+    s_NextTextureId = 0;
+    s_CreatedCount = 0;
+    s_DestroyedCount = 0;
+    IUnityXRDisplayInterface display = {};
+    display.CreateTexture = MockCreateTexture;
+    display.DestroyTexture = MockDestroyTexture;
+    return display;
+}
+
+// Side by side eye texture of a 1832x1920 per eye headset, at a render scale.
+static UnityXRRenderTextureDesc MakeDesc(float scale = 1.0f, UnityXRRenderTextureFormat colorFormat = kUnityXRRenderTextureFormatRGBA32)
+{
+    UnityXRRenderTextureDesc desc = {};
+    desc.colorFormat = colorFormat;
+    desc.color.nativePtr = (void*)kUnityXRRenderTextureIdDontCare;
+    desc.depthFormat = kUnityXRDepthTextureFormat24bitOrGreater;
+    desc.depth.nativePtr = (void*)kUnityXRRenderTextureIdDontCare;
+    desc.width = (uint32_t)(2 * 1832 * scale);
+    desc.height = (uint32_t)(1920 * scale);
+    return desc;
+}
+
+static void TestHitOnSameDesc()
+{
+    IUnityXRDisplayInterface display = MakeMockDisplay();
+    WebXRTexturePool pool;
+    pool.Initialize(&display, NULL);
+
+    UnityXRRenderTextureId first = pool.Acquire(MakeDesc());
+    assert(first != 0);
+    assert(pool.GetMisses() == 1 && pool.GetHits() == 0);
+
+    // In use, a second request with the same desc gets its own texture.
+    UnityXRRenderTextureId second = pool.Acquire(MakeDesc());
+    assert(second != first);
+    assert(pool.GetMisses() == 2);
+
+    // Released, the same desc reuses it without creating one.
+    pool.Release(first);
+    pool.NextFrame();
+    assert(pool.Acquire(MakeDesc()) == first);
+    assert(pool.GetHits() == 1);
+    assert(s_CreatedCount == 2);
+    assert(pool.GetTexturesCount() == 2);
+}
+
+static void TestMissOnChangedDesc()
+{
+    IUnityXRDisplayInterface display = MakeMockDisplay();
+    WebXRTexturePool pool;
+    pool.Initialize(&display, NULL);
+
+    UnityXRRenderTextureId full = pool.Acquire(MakeDesc());
+    pool.Release(full);
+    // Another render scale, another size.
+    UnityXRRenderTextureId scaled = pool.Acquire(MakeDesc(0.8f));
+    assert(scaled != full);
+    // Another color format at the same size.
+    UnityXRRenderTextureId rgb565 = pool.Acquire(MakeDesc(1.0f, kUnityXRRenderTextureFormatRGB565));
+    assert(rgb565 != full);
+    // Texture array, sRGB and depth format changes miss as well.
+    UnityXRRenderTextureDesc array = MakeDesc();
+    array.textureArrayLength = 2;
+    assert(pool.Acquire(array) != full);
+    UnityXRRenderTextureDesc sRGB = MakeDesc();
+    sRGB.flags = kUnityXRRenderTextureFlagsSRGB;
+    assert(pool.Acquire(sRGB) != full);
+    UnityXRRenderTextureDesc depth16 = MakeDesc();
+    depth16.depthFormat = kUnityXRDepthTextureFormat16bit;
+    assert(pool.Acquire(depth16) != full);
+    assert(pool.GetHits() == 0 && pool.GetMisses() == 6);
+
+    // Switching back to the full scale reuses the first texture.
+    pool.Release(scaled);
+    assert(pool.Acquire(MakeDesc()) == full);
+    assert(pool.GetHits() == 1);
+}
+
+static void TestEvictionAfterIdleFrames()
+{
+    IUnityXRDisplayInterface display = MakeMockDisplay();
+    WebXRTexturePool pool;
+    pool.Initialize(&display, NULL);
+
+    UnityXRRenderTextureId idle = pool.Acquire(MakeDesc());
+    UnityXRRenderTextureId used = pool.Acquire(MakeDesc(0.5f));
+    pool.Release(idle);
+
+    // Still there after kMaxUnusedFrames frames...
+    for (uint32_t frame = 0; frame < WebXRTexturePool::kMaxUnusedFrames; ++frame)
+    {
+        pool.NextFrame();
+    }
+    assert(pool.GetTexturesCount() == 2);
+    assert(s_DestroyedCount == 0);
+
+    // ...destroyed on the next one. The texture in use stays, however long it's held.
+    pool.NextFrame();
+    assert(pool.GetTexturesCount() == 1);
+    assert(s_DestroyedCount == 1);
+    assert(pool.Acquire(MakeDesc()) != idle);
+    assert(pool.GetHits() == 0);
+
+    // A texture reused before the limit restarts its idle count.
+    pool.Release(used);
+    for (uint32_t frame = 0; frame < WebXRTexturePool::kMaxUnusedFrames; ++frame)
+    {
+        pool.NextFrame();
+    }
+    assert(pool.Acquire(MakeDesc(0.5f)) == used);
+    pool.Release(used);
+    for (uint32_t frame = 0; frame < WebXRTexturePool::kMaxUnusedFrames; ++frame)
+    {
+        pool.NextFrame();
+    }
+    assert(pool.GetTexturesCount() == 2);
+
+    pool.Clear();
+    assert(pool.GetTexturesCount() == 0);
+    assert(s_DestroyedCount == s_CreatedCount);
+}
+
+int main()
+{
+    RUN_TEST(TestHitOnSameDesc);
+    RUN_TEST(TestMissOnChangedDesc);
+    RUN_TEST(TestEvictionAfterIdleFrames);
+    return 0;
+}
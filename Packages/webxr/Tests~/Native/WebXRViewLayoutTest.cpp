@@ -0,0 +1,113 @@
+#include "WebXRViewLayout.h"
+#include "WebXRTestUtils.h"
+
+// Pixel rect of a normalized view rect in the texture, placed at the bounding rect of the views.
+static UnityXRRectf ToFramebufferPixels(const WebXRViewLayout& layout, const UnityXRRectf& rect, float boundsX, float boundsY)
+{
+    float width = (float)layout.GetTextureWidth();
+    float height = (float)layout.GetTextureHeight();
+    return {boundsX + rect.x * width, boundsY + rect.y * height, rect.width * width, rect.height * height};
+}
+
+static void TestAsymmetricViewsSideBySide()
+{
+    // Padded framebuffer, views of different sizes away from its origin, the right one lower.
+    const float viewports[] = {
+        900.0f, 1000.0f, 100.0f, 60.0f,
+        1100.0f, 950.0f, 1000.0f, 20.0f
+    };
+    WebXRViewLayout layout;
+    layout.Update(viewports, 2, 2400.0f, 1200.0f);
+    assert(layout.GetViewsCount() == 2);
+
+    // Bounds from the left of the left view to the right of the right one,
+    // from the bottom of the right view to the top of the left one.
+    assert(layout.GetTextureWidth() == 2000);
+    assert(layout.GetTextureHeight() == 1040);
+
+    for (int view = 0; view < 2; ++view)
+    {
+        const float* viewport = viewports + view * 4;
+        UnityXRRectf pixels = ToFramebufferPixels(layout, layout.GetViewRect(view), 100.0f, 20.0f);
+        assert(IsNearRect(pixels, {viewport[2], viewport[3], viewport[0], viewport[1]}, 1e-2f));
+        assert(IsNearRect(layout.GetFramebufferRect(view), {viewport[2] / 2400.0f, viewport[3] / 1200.0f, viewport[0] / 2400.0f, viewport[1] / 1200.0f}));
+    }
+    assert(IsNearRect(layout.GetViewRect(0), {0.0f, 40.0f / 1040.0f, 0.45f, 1000.0f / 1040.0f}));
+    assert(IsNearRect(layout.GetViewRect(1), {0.45f, 0.0f, 0.55f, 950.0f / 1040.0f}));
+}
+
+static void TestStackedViews()
+{
+    // Views stacked vertically, the right eye at the bottom.
+    const float viewports[] = {
+        1000.0f, 800.0f, 0.0f, 800.0f,
+        1000.0f, 800.0f, 0.0f, 0.0f
+    };
+    WebXRViewLayout layout;
+    layout.Update(viewports, 2, 1000.0f, 1600.0f);
+    assert(layout.GetTextureWidth() == 1000);
+    assert(layout.GetTextureHeight() == 1600);
+    assert(IsNearRect(layout.GetViewRect(0), {0.0f, 0.5f, 1.0f, 0.5f}));
+    assert(IsNearRect(layout.GetViewRect(1), {0.0f, 0.0f, 1.0f, 0.5f}));
+}
+
+static void TestSingleView()
+{
+    // A mono session inside a padded framebuffer only allocates the view.
+    const float viewports[] = {1280.0f, 720.0f, 0.0f, 80.0f};
+    WebXRViewLayout layout;
+    layout.Update(viewports, 1, 1300.0f, 800.0f);
+    assert(layout.GetViewsCount() == 1);
+    assert(layout.GetTextureWidth() == 1280);
+    assert(layout.GetTextureHeight() == 720);
+    assert(IsNearRect(layout.GetViewRect(0), {0.0f, 0.0f, 1.0f, 1.0f}));
+    assert(IsNearRect(layout.GetFramebufferRect(0), {0.0f, 0.1f, 1280.0f / 1300.0f, 0.9f}));
+}
+
+static void TestMissingViewports()
+{
+    // Views without a size split the framebuffer evenly.
+    const float viewports[] = {
+        1000.0f, 1000.0f, 0.0f, 0.0f,
+        0.0f, 0.0f, 0.0f, 0.0f
+    };
+    WebXRViewLayout layout;
+    layout.Update(viewports, 2, 2000.0f, 1000.0f);
+    assert(layout.GetTextureWidth() == 2000);
+    assert(layout.GetTextureHeight() == 1000);
+    assert(IsNearRect(layout.GetViewRect(0), {0.0f, 0.0f, 0.5f, 1.0f}));
+    assert(IsNearRect(layout.GetViewRect(1), {0.5f, 0.0f, 0.5f, 1.0f}));
+
+    // Out of range views counts are clamped.
+    const float threeViewports[] = {
+        600.0f, 600.0f, 0.0f, 0.0f,
+        600.0f, 600.0f, 600.0f, 0.0f,
+        600.0f, 600.0f, 1200.0f, 0.0f
+    };
+    layout.Update(threeViewports, 3, 1800.0f, 600.0f);
+    assert(layout.GetViewsCount() == 2);
+    assert(layout.GetTextureWidth() == 1200);
+    layout.Update(threeViewports, 0, 1800.0f, 600.0f);
+    assert(layout.GetViewsCount() == 1);
+    assert(layout.GetTextureWidth() == 600);
+}
+
+static void TestRenderRect()
+{
+    UnityXRRectf viewRect = {0.45f, 0.0f, 0.55f, 950.0f / 1040.0f};
+    // From the view origin, never outside of the view.
+    UnityXRRectf rect = WebXRViewLayout::GetRenderRect(viewRect, {0.0f, 0.0f, 1.0f, 1.0f}, 0.5f);
+    assert(IsNearRect(rect, {0.45f, 0.0f, 0.275f, 475.0f / 1040.0f}));
+    rect = WebXRViewLayout::GetRenderRect(viewRect, {0.1f, 0.2f, 0.8f, 0.5f}, 1.0f);
+    assert(IsNearRect(rect, {0.45f + 0.1f * 0.55f, 0.2f * viewRect.height, 0.8f * 0.55f, 0.5f * viewRect.height}));
+}
+
+int main()
+{
+    RUN_TEST(TestAsymmetricViewsSideBySide);
+    RUN_TEST(TestStackedViews);
+    RUN_TEST(TestSingleView);
+    RUN_TEST(TestMissingViewports);
+    RUN_TEST(TestRenderRect);
+    return 0;
+}